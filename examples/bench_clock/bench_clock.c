@@ -0,0 +1,65 @@
+//
+// sk_app - Clock benchmark
+//
+// Times ska_time_get_elapsed_ns() with the OS clock and with
+// ska_init_info_t.fast_clock, in a tight loop:
+// - ns/call: what a profiler zone or an event timestamp pays per read
+// - backwards: reads that returned less than the one before, should be 0
+//
+// sk_app is initialized once per clock, so this needs a display on desktop.
+
+#include <sk_app.h>
+
+#define BENCH_CALLS        20000000
+#define BENCH_CALIBRATE_NS 500000000ULL // Longest we wait for the fast clock to calibrate
+
+static bool bench_run(const char* name, bool fast_clock) {
+	ska_init_info_t info = {0};
+	info.fast_clock = fast_clock;
+	if (!ska_init_ex(&info)) {
+		ska_log(ska_log_error, "Failed to initialize sk_app: %s", ska_error_get());
+		return false;
+	}
+
+	if (fast_clock) {
+		// The first reads calibrate the counter against the OS clock
+		uint64_t start_ns = ska_time_get_elapsed_ns();
+		while (!ska_time_is_fast_clock() && ska_time_get_elapsed_ns() - start_ns < BENCH_CALIBRATE_NS) {}
+		if (!ska_time_is_fast_clock()) {
+			ska_log(ska_log_info, "%-10s unavailable on this machine, skipped", name);
+			ska_shutdown();
+			return true;
+		}
+	}
+
+	uint64_t backwards = 0;
+	uint64_t last_ns   = ska_time_get_elapsed_ns();
+	uint64_t start_ns  = last_ns;
+	for (int32_t i = 0; i < BENCH_CALLS; i++) {
+		uint64_t now_ns = ska_time_get_elapsed_ns();
+		if (now_ns < last_ns) {
+			backwards++;
+		}
+		last_ns = now_ns;
+	}
+	uint64_t elapsed_ns = last_ns - start_ns;
+
+	ska_log(ska_log_info, "%-10s %6.1f ns/call  (%d calls, backwards %llu)",
+		name,
+		(double)elapsed_ns / (double)BENCH_CALLS,
+		BENCH_CALLS,
+		(unsigned long long)backwards);
+
+	ska_shutdown();
+	return true;
+}
+
+int32_t main(int argc, char** argv) {
+	(void)argc;
+	(void)argv;
+
+	ska_log(ska_log_info, "sk_app clock, ska_time_get_elapsed_ns()");
+	if (!bench_run("os clock",   false)) return 1;
+	if (!bench_run("fast clock", true))  return 1;
+	return 0;
+}
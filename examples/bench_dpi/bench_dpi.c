@@ -0,0 +1,61 @@
+//
+// sk_app - DPI benchmark
+//
+// Times ska_window_get_dpi_scale() in a tight loop. UI code like the imgui
+// backend asks for it every frame, so it should cost about as much as any
+// other cached window getter, which is timed alongside for reference:
+// - ns/call: average over BENCH_CALLS calls
+//
+// Needs a display on desktop, the window is created hidden.
+
+#include <sk_app.h>
+
+#define BENCH_CALLS 10000000
+
+int32_t main(int argc, char** argv) {
+	(void)argc;
+	(void)argv;
+
+	if (!ska_init()) {
+		ska_log(ska_log_error, "Failed to initialize sk_app: %s", ska_error_get());
+		return 1;
+	}
+
+	ska_window_t* window = ska_window_create("sk_app DPI Benchmark",
+		SKA_WINDOWPOS_CENTERED, SKA_WINDOWPOS_CENTERED, 320, 240, ska_window_hidden);
+	if (!window) {
+		ska_log(ska_log_error, "Failed to create window: %s", ska_error_get());
+		ska_shutdown();
+		return 1;
+	}
+
+	// Summed so the compiler can't drop the calls
+	volatile float sink = 0.0f;
+	float          sum  = 0.0f;
+
+	uint64_t start_ns = ska_time_get_elapsed_ns();
+	for (int32_t i = 0; i < BENCH_CALLS; i++) {
+		sum += ska_window_get_dpi_scale(window);
+	}
+	uint64_t dpi_ns = ska_time_get_elapsed_ns() - start_ns;
+	sink = sum;
+
+	int32_t  w, h;
+	uint64_t size_sum = 0;
+	start_ns = ska_time_get_elapsed_ns();
+	for (int32_t i = 0; i < BENCH_CALLS; i++) {
+		ska_window_get_content_size(window, &w, &h);
+		size_sum += (uint64_t)w;
+	}
+	uint64_t size_ns = ska_time_get_elapsed_ns() - start_ns;
+	sink = (float)size_sum;
+	(void)sink;
+
+	ska_log(ska_log_info, "sk_app DPI scale %.2f, %d calls each", ska_window_get_dpi_scale(window), BENCH_CALLS);
+	ska_log(ska_log_info, "%-28s %6.2f ns/call", "ska_window_get_dpi_scale",    (double)dpi_ns  / (double)BENCH_CALLS);
+	ska_log(ska_log_info, "%-28s %6.2f ns/call", "ska_window_get_content_size", (double)size_ns / (double)BENCH_CALLS);
+
+	ska_window_destroy(window);
+	ska_shutdown();
+	return 0;
+}
@@ -0,0 +1,232 @@
+//
+// sk_app - Event pipeline benchmark
+//
+// Pushes synthetic events through ska_event_push() and drains them with
+// ska_event_poll_batch(), frame by frame, for a few input mixes that stress
+// different parts of the queue:
+// - motion flood: high-rate mouse motion, exercises coalescing under pressure
+// - typing burst: key down/text/key up triples, feeds the text queue too
+// - resize storm: interactive window resizing, always coalesced
+//
+// Reports events/second and ns/event for push+poll, plus how many events
+// reached the app and how many were merged on the way.
+//
+// Last, a push/pop micro-benchmark of the ring slot alone, motion events
+// through a plain ring of ska_event_t (the public struct) against the 32-byte
+// compact slot sk_app's queue stores, packed on push and expanded into an
+// app-side batch on pop, at a few queue depths.
+
+#include <sk_app.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_FRAMES      20000
+#define BENCH_BATCH       256
+#define BENCH_SLOT_EVENTS (1 << 24) // Pushed and popped per ring depth
+#define BENCH_SLOT_DEPTH  65536     // Deepest ring measured, power of two
+
+typedef void (*bench_frame_fn)(int32_t frame);
+
+static void bench_motion_flood(int32_t frame) {
+	// A 1000Hz+ mouse on a busy frame
+	for (int32_t i = 0; i < 48; i++) {
+		ska_event_t event = {0};
+		event.type                   = ska_event_mouse_motion;
+		event.mouse_motion.window_id = 1;
+		event.mouse_motion.x         = (frame + i) % 1920;
+		event.mouse_motion.y         = (frame * 3 + i) % 1080;
+		event.mouse_motion.xrel      = 1;
+		event.mouse_motion.yrel      = -1;
+		ska_event_push(&event);
+	}
+}
+
+static void bench_typing_burst(int32_t frame) {
+	static const char* words[] = { "the ", "quick ", "brown ", "fox ", "jumps ", "über ", "日本語 " };
+	const char* word = words[frame % (int32_t)(sizeof(words) / sizeof(words[0]))];
+
+	for (int32_t i = 0; i < 4; i++) {
+		ska_event_t key = {0};
+		key.type               = ska_event_key_down;
+		key.keyboard.window_id = 1;
+		key.keyboard.scancode  = (ska_scancode_)(ska_scancode_a + (frame + i) % 26);
+		key.keyboard.pressed   = true;
+		ska_event_push(&key);
+
+		ska_text_push_utf8(word);
+
+		key.type             = ska_event_key_up;
+		key.keyboard.pressed = false;
+		ska_event_push(&key);
+	}
+}
+
+static void bench_resize_storm(int32_t frame) {
+	for (int32_t i = 0; i < 16; i++) {
+		ska_event_t event = {0};
+		event.type             = (i & 1) ? ska_event_window_moved : ska_event_window_resized;
+		event.window.window_id = 1;
+		event.window.data1     = 640 + (frame + i) % 640;
+		event.window.data2     = 480 + (frame + i) % 480;
+		ska_event_push(&event);
+	}
+}
+
+static void bench_run(const char* name, bench_frame_fn frame_fn) {
+	static ska_event_t events[BENCH_BATCH];
+
+	ska_event_queue_stats_t before;
+	ska_event_get_queue_stats(&before);
+
+	uint64_t delivered = 0;
+	uint64_t start_ns  = ska_time_get_elapsed_ns();
+	for (int32_t frame = 0; frame < BENCH_FRAMES; frame++) {
+		frame_fn(frame);
+
+		int32_t count;
+		while ((count = ska_event_poll_batch(events, BENCH_BATCH)) > 0) {
+			delivered += (uint64_t)count;
+		}
+		while (ska_text_consume() != 0) {}
+	}
+	uint64_t elapsed_ns = ska_time_get_elapsed_ns() - start_ns;
+
+	ska_event_queue_stats_t after;
+	ska_event_get_queue_stats(&after);
+	uint64_t coalesced = after.coalesced - before.coalesced;
+	uint64_t dropped   = after.dropped   - before.dropped;
+	uint64_t pushed    = delivered + coalesced + dropped;
+
+	double seconds = (double)elapsed_ns / 1000000000.0;
+	ska_log(ska_log_info, "%-14s %10.0f events/s %8.1f ns/event  (pushed %llu, delivered %llu, coalesced %llu, dropped %llu)",
+		name,
+		(double)pushed / seconds,
+		(double)elapsed_ns / (double)pushed,
+		(unsigned long long)pushed,
+		(unsigned long long)delivered,
+		(unsigned long long)coalesced,
+		(unsigned long long)dropped);
+}
+
+// Mirrors the layout of a motion event in sk_app's queue slots
+typedef struct bench_slot_compact_t {
+	uint64_t timestamp_ns;
+	uint32_t window_id;
+	uint8_t  type;
+	uint8_t  reserved[3];
+	int32_t  x, y, xrel, yrel;
+} bench_slot_compact_t;
+
+static ska_event_t          g_bench_ring_wide   [BENCH_SLOT_DEPTH];
+static bench_slot_compact_t g_bench_ring_compact[BENCH_SLOT_DEPTH];
+static ska_event_t          g_bench_pushed      [BENCH_BATCH];
+static ska_event_t          g_bench_popped      [BENCH_BATCH];
+static volatile int32_t     g_bench_sink;
+
+// Events to push come from a batch, the way a backend translates them
+static void bench_slot_init(void) {
+	for (int32_t i = 0; i < BENCH_BATCH; i++) {
+		ska_event_t* event = &g_bench_pushed[i];
+		event->type                   = ska_event_mouse_motion;
+		event->timestamp_ns           = (uint64_t)i;
+		event->mouse_motion.window_id = 1;
+		event->mouse_motion.x         = i * 7;
+		event->mouse_motion.y         = i * 3;
+		event->mouse_motion.xrel      = 1;
+		event->mouse_motion.yrel      = -1;
+	}
+}
+
+// Fills the ring to depth then drains it, until BENCH_SLOT_EVENTS went through
+static uint64_t bench_slot_wide(uint32_t depth) {
+	uint64_t start_ns = ska_time_get_elapsed_ns();
+	for (uint32_t base = 0; base < BENCH_SLOT_EVENTS; base += depth) {
+		for (uint32_t i = 0; i < depth; i++) {
+			g_bench_ring_wide[i] = g_bench_pushed[i % BENCH_BATCH];
+		}
+		for (uint32_t i = 0; i < depth; i++) {
+			g_bench_popped[i % BENCH_BATCH] = g_bench_ring_wide[i];
+		}
+	}
+	return ska_time_get_elapsed_ns() - start_ns;
+}
+
+static uint64_t bench_slot_compact(uint32_t depth) {
+	uint64_t start_ns = ska_time_get_elapsed_ns();
+	for (uint32_t base = 0; base < BENCH_SLOT_EVENTS; base += depth) {
+		for (uint32_t i = 0; i < depth; i++) {
+			const ska_event_t*    event = &g_bench_pushed[i % BENCH_BATCH];
+			bench_slot_compact_t* slot  = &g_bench_ring_compact[i];
+			slot->timestamp_ns = event->timestamp_ns;
+			slot->window_id    = event->mouse_motion.window_id;
+			slot->type         = (uint8_t)event->type;
+			slot->x            = event->mouse_motion.x;
+			slot->y            = event->mouse_motion.y;
+			slot->xrel         = event->mouse_motion.xrel;
+			slot->yrel         = event->mouse_motion.yrel;
+		}
+		for (uint32_t i = 0; i < depth; i++) {
+			const bench_slot_compact_t* slot = &g_bench_ring_compact[i];
+			ska_event_t*                out  = &g_bench_popped[i % BENCH_BATCH];
+			memset(out, 0, sizeof(*out));
+			out->type                   = (ska_event_)slot->type;
+			out->timestamp_ns           = slot->timestamp_ns;
+			out->mouse_motion.window_id = slot->window_id;
+			out->mouse_motion.x         = slot->x;
+			out->mouse_motion.y         = slot->y;
+			out->mouse_motion.xrel      = slot->xrel;
+			out->mouse_motion.yrel      = slot->yrel;
+		}
+	}
+	return ska_time_get_elapsed_ns() - start_ns;
+}
+
+static void bench_slot_run(uint32_t depth) {
+	uint64_t wide_ns    = bench_slot_wide(depth);
+	uint64_t compact_ns = bench_slot_compact(depth);
+
+	// Keeps the copies from being optimized out
+	for (int32_t i = 0; i < BENCH_BATCH; i++) {
+		g_bench_sink += g_bench_popped[i].mouse_motion.x;
+	}
+
+	double events = (double)BENCH_SLOT_EVENTS;
+	ska_log(ska_log_info, "depth %-6u %2d-byte slot %6.2f ns/event %6.1f M events/s   %2d-byte slot %6.2f ns/event %6.1f M events/s",
+		depth,
+		(int32_t)sizeof(ska_event_t),          (double)wide_ns    / events, events / ((double)wide_ns    / 1000.0),
+		(int32_t)sizeof(bench_slot_compact_t), (double)compact_ns / events, events / ((double)compact_ns / 1000.0));
+}
+
+int32_t main(int argc, char** argv) {
+	(void)argc;
+	(void)argv;
+
+	if (!ska_init()) {
+		ska_log(ska_log_error, "Failed to initialize sk_app: %s", ska_error_get());
+		return 1;
+	}
+
+	// Probe once, some platforms produce events on another thread
+	ska_event_t probe = {0};
+	probe.type = ska_event_window_shown;
+	if (!ska_event_push(&probe)) {
+		ska_log(ska_log_error, "Event injection unavailable: %s", ska_error_get());
+		ska_shutdown();
+		return 1;
+	}
+	while (ska_event_poll(&probe)) {}
+
+	ska_log(ska_log_info, "sk_app event pipeline, %d frames per mix", BENCH_FRAMES);
+	bench_run("motion flood", bench_motion_flood);
+	bench_run("typing burst", bench_typing_burst);
+	bench_run("resize storm", bench_resize_storm);
+
+	ska_log(ska_log_info, "sk_app queue slot push/pop, motion events, %d per depth", BENCH_SLOT_EVENTS);
+	bench_slot_init();
+	bench_slot_run(256);
+	bench_slot_run(4096);
+	bench_slot_run(BENCH_SLOT_DEPTH);
+
+	ska_shutdown();
+	return 0;
+}
@@ -0,0 +1,144 @@
+//
+// sk_app - Platform pump benchmark (X11)
+//
+// Every frame a second display connection sends a burst of MotionNotify
+// events to an sk_app window, then the frame drains them one of three ways
+// and reports how many XPending calls that took. Each XPending flushes the
+// output buffer and tries to read the socket, so this is the per-frame
+// syscall cost of draining the queue:
+// - pump per event: ska_event_poll_batch() one event at a time, what
+//   ska_event_poll() cost when it pumped on every call
+// - poll: ska_event_poll() in a loop, pumps only once the queue is empty
+// - poll batch: ska_event_poll_batch(), one pump per call
+//
+// XPending is counted by defining it here, ahead of libX11, and forwarding
+// to the real one. Needs a display; headless, run it under Xvfb:
+//   xvfb-run ./sk_app_bench_pump
+
+#define _GNU_SOURCE
+#include <sk_app.h>
+#include <X11/Xlib.h>
+#include <dlfcn.h>
+
+#define BENCH_FRAMES 2000
+#define BENCH_BURST  48  // A 1000Hz+ mouse on a busy frame
+#define BENCH_BATCH  256
+
+typedef int32_t (*bench_drain_fn)(void);
+
+static int    (*g_bench_xpending)(Display*);
+static uint64_t g_bench_xpending_calls;
+
+int XPending(Display* display) {
+	g_bench_xpending_calls++;
+	return g_bench_xpending(display);
+}
+
+static void bench_send_burst(Display* sender, Window target, int32_t frame) {
+	for (int32_t i = 0; i < BENCH_BURST; i++) {
+		XEvent xev = {0};
+		xev.xmotion.type        = MotionNotify;
+		xev.xmotion.display     = sender;
+		xev.xmotion.window      = target;
+		xev.xmotion.same_screen = True;
+		xev.xmotion.x           = (frame + i) % 640;
+		xev.xmotion.y           = (frame * 3 + i) % 480;
+		XSendEvent(sender, target, False, PointerMotionMask, &xev);
+	}
+	// Once the server has answered, the whole burst is on its way to us
+	XSync(sender, False);
+}
+
+static int32_t bench_drain_pump_each(void) {
+	ska_event_t event;
+	int32_t     count = 0;
+	while (ska_event_poll_batch(&event, 1) == 1) {
+		count++;
+	}
+	return count;
+}
+
+static int32_t bench_drain_poll(void) {
+	ska_event_t event;
+	int32_t     count = 0;
+	while (ska_event_poll(&event)) {
+		count++;
+	}
+	return count;
+}
+
+static int32_t bench_drain_batch(void) {
+	static ska_event_t events[BENCH_BATCH];
+	int32_t count = 0;
+	int32_t got;
+	do {
+		got    = ska_event_poll_batch(events, BENCH_BATCH);
+		count += got;
+	} while (got == BENCH_BATCH);
+	return count;
+}
+
+static void bench_run(const char* name, Display* sender, Window target, bench_drain_fn drain_fn) {
+	uint64_t delivered = 0;
+	uint64_t drain_ns  = 0;
+	uint64_t calls     = g_bench_xpending_calls;
+	for (int32_t frame = 0; frame < BENCH_FRAMES; frame++) {
+		bench_send_burst(sender, target, frame);
+
+		uint64_t start_ns = ska_time_get_elapsed_ns();
+		delivered += (uint64_t)drain_fn();
+		drain_ns  += ska_time_get_elapsed_ns() - start_ns;
+	}
+
+	double frames = (double)BENCH_FRAMES;
+	ska_log(ska_log_info, "%-14s %7.1f events/frame %7.1f XPending/frame %8.2f us draining/frame",
+		name,
+		(double)delivered / frames,
+		(double)(g_bench_xpending_calls - calls) / frames,
+		(double)drain_ns / frames / 1000.0);
+}
+
+int32_t main(int argc, char** argv) {
+	(void)argc;
+	(void)argv;
+
+	// POSIX's way around ISO C's ban on object to function pointer casts
+	*(void**)&g_bench_xpending = dlsym(RTLD_NEXT, "XPending");
+	if (!g_bench_xpending) {
+		ska_log(ska_log_error, "Failed to find libX11's XPending");
+		return 1;
+	}
+
+	if (!ska_init()) {
+		ska_log(ska_log_error, "Failed to initialize sk_app: %s", ska_error_get());
+		return 1;
+	}
+
+	ska_window_t* window = ska_window_create("sk_app Pump Benchmark",
+		SKA_WINDOWPOS_CENTERED, SKA_WINDOWPOS_CENTERED, 640, 480, 0);
+	Display*      sender = XOpenDisplay(NULL);
+	if (!window || !sender) {
+		ska_log(ska_log_error, "Failed to set up: %s", window ? "no second display connection" : ska_error_get());
+		if (sender) XCloseDisplay(sender);
+		ska_shutdown();
+		return 1;
+	}
+	Window target = (Window)(uintptr_t)ska_window_get_native_handle(window);
+
+	// Let the window map, then throw away whatever that produced
+	ska_event_t event;
+	for (int32_t i = 0; i < 60; i++) {
+		while (ska_event_poll(&event)) {}
+		ska_time_sleep(5);
+	}
+
+	ska_log(ska_log_info, "sk_app platform pumps per frame, %d motion events per frame, %d frames", BENCH_BURST, BENCH_FRAMES);
+	bench_run("pump per event", sender, target, bench_drain_pump_each);
+	bench_run("poll",           sender, target, bench_drain_poll);
+	bench_run("poll batch",     sender, target, bench_drain_batch);
+
+	XCloseDisplay(sender);
+	ska_window_destroy(window);
+	ska_shutdown();
+	return 0;
+}
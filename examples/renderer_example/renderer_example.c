@@ -261,6 +261,10 @@ int32_t main(int32_t argc, char** argv) {
 	double   start_time   = ska_time_get_elapsed_s();
 	bool     running      = true;
 
+	// Paces retries while the swapchain can't be acquired (e.g. minimized)
+	ska_frame_pacer_t idle_pacer;
+	ska_frame_pacer_init(&idle_pacer, window, 0.0f);
+
 	while (running) {
 		ska_event_t event;
 
@@ -420,7 +424,7 @@ int32_t main(int32_t argc, char** argv) {
 				skr_surface_resize(&surface);
 				recreate_depth_buffer(&depth_buffer, &surface);
 			} else if (acquire_result != skr_acquire_success) {
-				ska_time_sleep(16);
+				ska_frame_pacer_wait(&idle_pacer);
 			}
 		}
 
@@ -0,0 +1,89 @@
+//
+// sk_app - Round trip check
+//
+// Runs steady-state frames of event polling plus the geometry and DPI
+// queries a typical app makes every frame, and fails if any of them blocked
+// on a display server round trip (ska_frame_stats_t.display_round_trips).
+// Only X11 has round trips to count, elsewhere this always passes.
+//
+// Needs a display; headless, run it under Xvfb:
+//   xvfb-run ./sk_app_round_trips
+// Configure with -DSKA_X11_AUDIT=ON to have sk_app log the offending calls.
+
+#include <sk_app.h>
+
+#define CHECK_WARMUP_FRAMES 60  // Let the window map and the window manager settle
+#define CHECK_FRAMES        300
+
+static bool check_frame(ska_window_t* window) {
+	ska_event_t event;
+	while (ska_event_poll(&event)) {
+		if (event.type == ska_event_quit || event.type == ska_event_window_close) {
+			return false;
+		}
+	}
+
+	int32_t x, y, w, h;
+	ska_window_get_content_size(window, &w, &h);
+	ska_window_get_content_position(window, &x, &y);
+	ska_window_get_frame_size(window, &w, &h);
+	ska_window_get_frame_position(window, &x, &y);
+	ska_window_get_drawable_size(window, &w, &h);
+	(void)ska_window_get_dpi_scale(window);
+	return true;
+}
+
+int32_t main(int argc, char** argv) {
+	(void)argc;
+	(void)argv;
+
+	if (!ska_init()) {
+		ska_log(ska_log_error, "Failed to initialize sk_app: %s", ska_error_get());
+		return 1;
+	}
+
+	ska_window_t* window = ska_window_create("sk_app Round Trips",
+		SKA_WINDOWPOS_CENTERED, SKA_WINDOWPOS_CENTERED, 640, 480, ska_window_resizable);
+	if (!window) {
+		ska_log(ska_log_error, "Failed to create window: %s", ska_error_get());
+		ska_shutdown();
+		return 1;
+	}
+
+	ska_frame_pacer_t pacer;
+	ska_frame_pacer_init(&pacer, window, 0.0f);
+
+	int32_t frame   = 0;
+	bool    running = true;
+	for (; running && frame < CHECK_WARMUP_FRAMES + CHECK_FRAMES; frame++) {
+		if (frame == CHECK_WARMUP_FRAMES) {
+			ska_frame_stats_reset();
+		}
+
+		ska_frame_begin(window);
+		running = check_frame(window);
+		ska_frame_end();
+		ska_frame_pacer_wait(&pacer);
+	}
+
+	ska_frame_stats_t stats;
+	ska_frame_stats_get(&stats);
+	ska_log(ska_log_info, "%llu frames, %llu round trips (most in one frame: %u), p99 %.2f ms",
+		(unsigned long long)stats.frames,
+		(unsigned long long)stats.display_round_trips,
+		stats.display_round_trips_max,
+		(double)stats.frame_p99_ns / 1000000.0);
+
+	bool passed = running && stats.display_round_trips == 0;
+	if (!running) {
+		ska_log(ska_log_error, "Window closed before the check finished");
+	} else if (!passed) {
+		ska_log(ska_log_error, "FAIL: steady-state frames waited on the display server");
+	} else {
+		ska_log(ska_log_info, "PASS: no round trips in steady-state frames");
+	}
+
+	ska_window_destroy(window);
+	ska_shutdown();
+	return passed ? 0 : 1;
+}
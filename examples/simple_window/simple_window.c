@@ -107,6 +107,16 @@ int32_t main(int argc, char** argv) {
 	ska_log(ska_log_info, "[WINDOW] Refresh rate:  %.2f Hz", ska_window_get_refresh_rate(window));
 	ska_log(ska_log_info, "[WINDOW] Flags:         0x%08X", flags);
 
+	for (int32_t i = 0; i < ska_display_count(); i++) {
+		ska_display_info_t display;
+		if (ska_display_get_info(i, &display)) {
+			ska_log(ska_log_info, "[DISPLAY] %d '%s': %dx%d at (%d,%d), work area %dx%d, %.2f Hz, scale %.2f%s",
+				i, display.name, display.width, display.height, display.x, display.y,
+				display.work_width, display.work_height, display.refresh_rate, display.dpi_scale,
+				display.is_primary ? " (primary)" : "");
+		}
+	}
+
 // ========================================================================
 // FILE I/O DEMONSTRATION
 // ========================================================================
@@ -220,6 +230,9 @@ int32_t main(int argc, char** argv) {
 	bool     cursor_visible  = true;
 	bool     text_input_mode = false;
 
+	ska_frame_pacer_t pacer;
+	ska_frame_pacer_init(&pacer, window, 60.0f);
+
 	while (running) {
 		ska_event_t event;
 
@@ -244,6 +257,10 @@ int32_t main(int argc, char** argv) {
 					ska_log(ska_log_info, "[EVENT] Window moved to (%d, %d)", event.window.data1, event.window.data2);
 					break;
 
+				case ska_event_display_changed:
+					ska_log(ska_log_info, "[EVENT] Displays changed, %d connected", event.window.data1);
+					break;
+
 				case ska_event_window_focus_gained:
 					ska_log(ska_log_info, "[EVENT] Window gained focus");
 					break;
@@ -509,8 +526,8 @@ int32_t main(int argc, char** argv) {
 			ska_log(ska_log_info, "[TIMING] Elapsed time: %.3f s, Frame: %u", elapsed, frame);
 		}
 
-		// Simulate frame timing - ~60 FPS
-		ska_time_sleep(16);
+		// Simulate frame timing - 60 FPS
+		ska_frame_pacer_wait(&pacer);
 		frame++;
 
 		// Test mode: exit after N frames
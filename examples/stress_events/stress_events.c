@@ -0,0 +1,178 @@
+//
+// sk_app - Cross-thread event queue stress test
+//
+// A producer thread pushes numbered events into an event queue and numbered
+// codepoints into the text queue, the way Android's looper thread does, while
+// the main thread drains both with a mix of single and batch pops, checking
+// that every item arrives exactly once and in order. The event queue starts
+// tiny and both sides stall now and then, so segments get chained, drained and
+// freed while the other side is running, and commits land at odd batch sizes.
+//
+// Drives the queues through ska_internal.h, no display needed. Built with
+// -fsanitize=thread, together with its own instrumented copy of sk_app:
+//   ./sk_app_stress_events
+
+#include "ska_internal.h"
+#include <pthread.h>
+#include <sched.h>
+
+#define STRESS_EVENTS       2000000
+#define STRESS_CODEPOINTS   200000
+#define STRESS_BATCH        64
+#define STRESS_MAX_CAPACITY 4096
+#define STRESS_STALL_NS     2000000000ULL // No progress for this long fails the run
+
+static ska_event_queue_t g_stress_queue;
+static uint64_t          g_stress_full; // Producer retries on a full queue, producer thread only
+
+// Codepoints cycle through 'a'..'z'
+static uint32_t stress_codepoint(int32_t i) {
+	return 'a' + (uint32_t)(i % 26);
+}
+
+static void* stress_producer(void* arg) {
+	(void)arg;
+	ska_text_queue_t* text      = &g_ska.input_state.text_queue;
+	int32_t           next_text = 0;
+
+	for (int32_t i = 0; i < STRESS_EVENTS; ) {
+		ska_event_t event = {0};
+		event.type           = ska_event_mouse_motion;
+		event.mouse_motion.x = i;
+		if (!ska_event_queue_push(&g_stress_queue, &event, (uint64_t)i + 1, false)) {
+			// At the cap, publish what we have and let the consumer catch up
+			g_stress_full++;
+			ska_event_queue_commit(&g_stress_queue);
+			sched_yield();
+			continue;
+		}
+		i++;
+
+		// Commit at uneven intervals so batches straddle segment boundaries
+		if (i % (1 + i % 13) == 0) {
+			ska_event_queue_commit(&g_stress_queue);
+		}
+
+		// The text queue drops when full, so only push while there is room
+		uint32_t write_pos = atomic_load_explicit(&text->write_pos, memory_order_relaxed);
+		uint32_t read_pos  = atomic_load_explicit(&text->read_pos,  memory_order_acquire);
+		if (next_text < STRESS_CODEPOINTS && write_pos - read_pos < SKA_TEXT_QUEUE_SIZE) {
+			char utf8[2] = { (char)stress_codepoint(next_text), 0 };
+			ska_text_queue_push_utf8(text, utf8);
+			next_text++;
+		}
+	}
+	ska_event_queue_commit(&g_stress_queue);
+
+	while (next_text < STRESS_CODEPOINTS) {
+		uint32_t write_pos = atomic_load_explicit(&text->write_pos, memory_order_relaxed);
+		uint32_t read_pos  = atomic_load_explicit(&text->read_pos,  memory_order_acquire);
+		if (write_pos - read_pos < SKA_TEXT_QUEUE_SIZE) {
+			char utf8[2] = { (char)stress_codepoint(next_text), 0 };
+			ska_text_queue_push_utf8(text, utf8);
+			next_text++;
+		} else {
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+// Returns false on the first out of order event
+static bool stress_receive(const ska_event_t* event, int32_t* ref_expected) {
+	if (event->type != ska_event_mouse_motion || event->mouse_motion.x != *ref_expected ||
+		event->timestamp_ns != (uint64_t)*ref_expected + 1) {
+		ska_log(ska_log_error, "Expected event %d, got type %d value %d", *ref_expected, (int32_t)event->type, event->mouse_motion.x);
+		return false;
+	}
+	(*ref_expected)++;
+	return true;
+}
+
+int32_t main(int argc, char** argv) {
+	(void)argc;
+	(void)argv;
+
+	ska_text_queue_init(&g_ska.input_state.text_queue);
+	if (!ska_event_queue_init(&g_stress_queue, 4, STRESS_MAX_CAPACITY)) {
+		ska_log(ska_log_error, "Failed to create the event queue");
+		return 1;
+	}
+
+	pthread_t producer;
+	if (pthread_create(&producer, NULL, stress_producer, NULL) != 0) {
+		ska_log(ska_log_error, "Failed to start the producer thread");
+		ska_event_queue_free(&g_stress_queue);
+		return 1;
+	}
+
+	static ska_event_t events[STRESS_BATCH];
+	int32_t  expected      = 0;
+	int32_t  expected_text = 0;
+	bool     ordered       = true;
+	uint64_t start_ns      = ska_time_get_elapsed_ns();
+	uint64_t progress_ns   = start_ns;
+	for (uint32_t round = 0; ordered && (expected < STRESS_EVENTS || expected_text < STRESS_CODEPOINTS); round++) {
+		int32_t received = expected + expected_text;
+
+		ska_event_t event;
+		switch (round % 4) {
+		case 0:
+			while (ordered && ska_event_queue_pop(&g_stress_queue, &event)) {
+				ordered = stress_receive(&event, &expected);
+			}
+			break;
+		case 1:
+		case 2: {
+			// Odd batch sizes too, so batches end mid-segment
+			int32_t max   = round % 4 == 1 ? STRESS_BATCH : 1 + (int32_t)(round % 7);
+			int32_t count = ska_event_queue_pop_batch(&g_stress_queue, events, max);
+			for (int32_t i = 0; ordered && i < count; i++) {
+				ordered = stress_receive(&events[i], &expected);
+			}
+			break;
+		}
+		case 3:
+			// Let the queue back up now and then so the producer has to grow it
+			if (round % 4096 == 3) {
+				ska_time_sleep(1);
+			}
+			break;
+		}
+
+		uint32_t codepoint;
+		while (ordered && (codepoint = ska_text_consume()) != 0) {
+			if (codepoint != stress_codepoint(expected_text)) {
+				ska_log(ska_log_error, "Expected codepoint %d to be U+%04X, got U+%04X", expected_text, stress_codepoint(expected_text), codepoint);
+				ordered = false;
+			}
+			expected_text++;
+		}
+
+		// Nothing for a while with items still missing means they were lost
+		uint64_t now_ns = ska_time_get_elapsed_ns();
+		if (expected + expected_text != received) {
+			progress_ns = now_ns;
+		} else if (now_ns - progress_ns > STRESS_STALL_NS) {
+			ska_log(ska_log_error, "No progress for %d ms after event %d, codepoint %d",
+				(int32_t)(STRESS_STALL_NS / 1000000), expected, expected_text);
+			break;
+		}
+	}
+	uint64_t elapsed_ns = ska_time_get_elapsed_ns() - start_ns;
+	pthread_join(producer, NULL);
+
+	int32_t capacity   = (int32_t)atomic_load_explicit(&g_stress_queue.capacity,   memory_order_relaxed);
+	int32_t high_water = (int32_t)atomic_load_explicit(&g_stress_queue.high_water, memory_order_relaxed);
+	bool    empty      = ska_event_queue_is_empty(&g_stress_queue);
+	ska_event_queue_free(&g_stress_queue);
+
+	if (!ordered || expected != STRESS_EVENTS || expected_text != STRESS_CODEPOINTS || !empty) {
+		ska_log(ska_log_error, "FAIL: received %d of %d events and %d of %d codepoints in order",
+			expected, STRESS_EVENTS, expected_text, STRESS_CODEPOINTS);
+		return 1;
+	}
+	ska_log(ska_log_info, "OK: %d events and %d codepoints in order, %.1f ns/event, queue grew to %d (high water %d, producer found it full %llu times)",
+		STRESS_EVENTS, STRESS_CODEPOINTS, (double)elapsed_ns / (double)STRESS_EVENTS, capacity, high_water, (unsigned long long)g_stress_full);
+	return 0;
+}
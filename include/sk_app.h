@@ -69,6 +69,40 @@ typedef        uint32_t     ska_window_id_t;
 // @return true on success, false on failure (check ska_error_get())
 SKA_API bool ska_init(void);
 
+// Optional settings for ska_init_ex(). Zero-initialize and set only what you need,
+// any field left at 0 uses its default.
+typedef struct ska_init_info_t {
+	int32_t event_queue_capacity;     // Initial event queue size, rounded up to a power of two (default 256)
+	int32_t event_queue_max_capacity; // Hard cap the event queue may grow to when full (default 65536)
+	int32_t event_coalesce_threshold; // Queued events before consecutive motion/wheel events merge (default 64, < 0 never)
+
+	// Read and translate input on a background thread as it arrives, instead of
+	// on the app thread during ska_event_poll() (X11 only, ignored elsewhere).
+	// Timestamps then reflect arrival time rather than poll time. Keyboard and
+	// mouse state queries follow the input thread, so they may run ahead of the
+	// events your loop has polled so far. The same goes for window getters
+	// (size, position, focus, visibility, frame extents): the input thread
+	// writes those fields without synchronizing with the app thread, so a
+	// getter can return a torn or half-updated value while the window is being
+	// resized or moved. Track geometry from the resized/moved events instead
+	// when you need a consistent view.
+	bool    input_thread;
+
+	// Read ska_time_get_elapsed_ns() from the CPU's invariant cycle counter
+	// (TSC on x86, CNTVCT on arm64) instead of asking the OS, calibrated
+	// against the OS monotonic clock and re-synced once a second. Falls back
+	// to the OS clock by itself when the counter isn't trustworthy. The first
+	// ~50ms after ska_init_ex() still use the OS clock while calibrating.
+	bool    fast_clock;
+} ska_init_info_t;
+
+// Initialize the sk_app library with custom settings.
+// Same as ska_init(), which is equivalent to ska_init_ex(NULL).
+//
+// @param opt_info Initialization settings (can be NULL for defaults)
+// @return true on success, false on failure (check ska_error_get())
+SKA_API bool ska_init_ex(const ska_init_info_t* opt_info);
+
 // Shutdown the sk_app library.
 // Automatically destroys any remaining windows, then cleans up platform resources.
 // Safe to call even if not initialized (no-op).
@@ -113,7 +147,7 @@ typedef struct ska_rect_t {
 // Window is initially visible unless ska_window_hidden flag is set.
 // Defaults to "sk_app window" if title is NULL, 640x480 if dimensions <= 0.
 // SKA_WINDOWPOS_UNDEFINED maps to (100,100), SKA_WINDOWPOS_CENTERED is platform-centered.
-// Maximum of SKA_MAX_WINDOWS (16) can be created simultaneously.
+// There is no fixed window limit beyond 65535 open at once.
 //
 // @param title Window title (UTF-8), copied internally
 // @param x X position in screen coordinates (or SKA_WINDOWPOS_UNDEFINED/SKA_WINDOWPOS_CENTERED)
@@ -138,14 +172,17 @@ SKA_API void ska_window_destroy(ska_window_t* ref_window);
 
 // Get window ID (for event handling).
 // IDs are stable for the lifetime of the window and used in event structures.
+// Each carries a generation, so an ID stops resolving once its window is
+// destroyed, even after a new window takes the same slot. An ID value only
+// comes back after 65536 windows have been created in one slot.
 // Returns 0 if window is NULL.
 //
 // @param window Window handle
-// @return Unique window ID (never reused during program lifetime)
+// @return Unique window ID, never 0
 SKA_API ska_window_id_t ska_window_get_id(const ska_window_t* window);
 
 // Get window from ID.
-// Performs linear search through active windows (max 16), so O(n) complexity.
+// Constant time, the ID indexes the window table directly.
 //
 // @param id Window ID from an event
 // @return Window handle, or NULL if window was destroyed or ID is invalid
@@ -257,6 +294,8 @@ SKA_API void ska_window_get_drawable_size(ska_window_t* ref_window, int32_t* opt
 // Returns the OS-level UI scaling factor (e.g., 1.0 for 100%, 1.5 for 150%, 2.0 for 200%).
 // This is useful for scaling UI elements like fonts to match the user's display preferences.
 // Note: This is different from DisplayFramebufferScale which handles pixel density.
+// The value is cached per window and refreshed when the OS reports a change
+// (ska_event_window_dpi_changed), so it is cheap enough to call every frame.
 //
 // Platform behavior:
 // - Linux X11: Reads Xft.dpi from Xresources, falls back to 96 DPI as baseline
@@ -274,7 +313,8 @@ SKA_API float ska_window_get_dpi_scale(const ska_window_t* window);
 // is primarily displayed.
 //
 // Platform notes:
-// - Linux/X11: Uses XRandR to query the current CRTC refresh rate
+// - Linux/X11: Rate of the XRandR monitor the window overlaps most, from the
+//   cached display list
 // - Win32: Uses EnumDisplaySettings on the monitor containing the window
 // - macOS: Uses CGDisplayModeGetRefreshRate on the window's screen
 // - Android: Uses JNI to call Display.getRefreshRate()
@@ -329,6 +369,44 @@ SKA_API void ska_window_raise(ska_window_t* ref_window);
 // @return Creation flags (ska_window_), or 0 if window is NULL
 SKA_API uint32_t ska_window_get_flags(const ska_window_t* window);
 
+// ============================================================================
+// Displays
+// ============================================================================
+
+// One monitor. Positions are in the same desktop coordinates as window
+// positions, the work area leaves out panels, docks and taskbars.
+typedef struct ska_display_info_t {
+	char    name[64];     // OS name for the output (e.g. "DP-1" on X11), may be empty
+	int32_t x, y;
+	int32_t width, height;
+	int32_t work_x, work_y;
+	int32_t work_width, work_height;
+	float   refresh_rate; // Hz, 0.0f if unknown
+	float   dpi_scale;    // Same scale ska_window_get_dpi_scale() reports for windows on it
+	bool    is_primary;
+} ska_display_info_t;
+
+// Get the number of connected displays.
+// Backends keep the list cached and update it when the OS reports a change,
+// which also posts ska_event_display_changed, so this is cheap to call.
+//
+// Platform notes:
+// - Linux/X11: XRandR monitors (XRRGetMonitors, or active CRTCs before RandR 1.5)
+// - Win32: EnumDisplayMonitors, refreshed on WM_DISPLAYCHANGE
+// - macOS: [NSScreen screens], no change event
+// - Android: The one display the app runs on
+//
+// @return Number of displays, at least 1 once sk_app is initialized
+SKA_API int32_t ska_display_count(void);
+
+// Get information about a display.
+// Index 0 is not necessarily the primary display, check is_primary.
+//
+// @param index Display index, 0 to ska_display_count() - 1
+// @param out_info Receives the display information
+// @return true on success, false if index is out of range
+SKA_API bool ska_display_get_info(int32_t index, ska_display_info_t* out_info);
+
 // ============================================================================
 // Event System
 // ============================================================================
@@ -371,6 +449,15 @@ typedef enum ska_event_ {
 
 	// File dialog events
 	ska_event_file_dialog,
+
+	// User events
+	ska_event_user, // Posted by ska_event_push_user()
+
+	// Timer events
+	ska_event_timer, // A timer from ska_timer_add() is due
+
+	// Display events
+	ska_event_display_changed, // Displays were added, removed or reconfigured, see ska_display_get_info()
 } ska_event_;
 
 // Keyboard scancodes (physical keys)
@@ -479,6 +566,7 @@ typedef enum ska_mouse_button_ {
 // - ska_event_window_resized:    data1 = new width,  data2 = new height
 // - ska_event_window_moved:      data1 = new x,      data2 = new y
 // - ska_event_window_dpi_changed: data1 = new scale percentage (e.g., 150 = 1.5x)
+// - ska_event_display_changed:   window_id = 0, data1 = new ska_display_count()
 typedef struct ska_event_window_t {
 	ska_window_id_t   window_id;
 	int32_t           data1;
@@ -540,10 +628,31 @@ typedef struct ska_event_file_dialog_t {
 	void*                 _internal;    // Internal data, do not access directly
 } ska_event_file_dialog_t;
 
+// Values passed to ska_event_push_user(), sk_app doesn't look at them
+typedef struct ska_event_user_t {
+	int32_t           code;
+	void*             data1;
+	void*             data2;
+} ska_event_user_t;
+
+typedef uint32_t ska_timer_id_t;
+
+// Delivered when a timer from ska_timer_add() is due. The event's timestamp_ns
+// is the deadline it was due at, so lateness is easy to measure.
+typedef struct ska_event_timer_t {
+	ska_timer_id_t    timer_id;
+	uint32_t          expirations; // Intervals elapsed since the last event, > 1 when a repeating timer fell behind
+	void*             user_data;   // Passed to ska_timer_add()
+} ska_event_timer_t;
+
 // Main event structure
+// On X11, timestamp_ns is when the input happened according to the X server
+// (millisecond resolution, mapped onto the sk_app clock). Other platforms
+// stamp events when sk_app receives them.
 typedef struct ska_event_t {
 	ska_event_ type;
-	uint32_t   timestamp;
+	uint32_t   timestamp;    // Milliseconds since ska_init(), wraps after ~49 days (kept for compatibility)
+	uint64_t   timestamp_ns; // Nanoseconds since ska_init(), same clock as ska_time_get_elapsed_ns()
 	union {
 		ska_event_window_t       window;
 		ska_event_keyboard_t     keyboard;
@@ -552,11 +661,20 @@ typedef struct ska_event_t {
 		ska_event_mouse_button_t mouse_button;
 		ska_event_mouse_wheel_t  mouse_wheel;
 		ska_event_file_dialog_t  file_dialog;
+		ska_event_user_t         user;
+		ska_event_timer_t        timer;
 	};
 } ska_event_t;
 
 // Poll for events.
-// Pumps platform events first, then dequeues from internal ring buffer (256 events max).
+// Pumps platform events when the internal event queue is empty, then dequeues
+// one event from it. The queue starts at 256 events and doubles when full, up to
+// ska_init_info_t.event_queue_max_capacity.
+// Consecutive resize/move events for a window are merged into one carrying the
+// final geometry. Once the queue backs up (event_coalesce_threshold), consecutive
+// motion events are merged too (xrel/yrel summed) as are wheel events (deltas
+// summed). At the hard cap, motion/wheel/resize/move are dropped first; a reserve
+// of slots is kept so key, button, focus, close and quit events are not lost.
 // Text input events are automatically pushed to the text queue for ska_text_consume().
 // Non-blocking: returns immediately if queue is empty.
 //
@@ -564,16 +682,137 @@ typedef struct ska_event_t {
 // @return true if event was retrieved, false if no events available
 SKA_API bool ska_event_poll(ska_event_t* out_event);
 
+// Poll for up to max_events events at once.
+// Pumps platform events once, then copies as many queued events as fit into
+// out_events. Cheaper than calling ska_event_poll() in a loop when a frame has
+// many events (e.g. mouse motion floods). Text input events feed the text queue
+// just like ska_event_poll().
+//
+// @param out_events Array of at least max_events events to fill (required, not NULL)
+// @param max_events Capacity of out_events
+// @return Number of events written, 0 if none were available
+SKA_API int32_t ska_event_poll_batch(ska_event_t* out_events, int32_t max_events);
+
+// Inject an event as if the platform had produced it.
+// Goes through the same path as platform events: coalescing, overflow policy,
+// and text input events feeding the text queue once polled. timestamp and
+// timestamp_ns may be left at 0 to stamp the event now. The event shows up
+// on the next ska_event_poll() once everything queued before it is drained.
+// Call from the thread that polls events. With ska_init_info_t.input_thread
+// or on Android, where events come from another thread, it is handed over
+// like ska_event_push_user(), so a queue overflow can't be reported.
+//
+// @param event Event to queue (required, not NULL)
+// @return true if queued, false if dropped or unavailable (check ska_error_get())
+SKA_API bool ska_event_push(const ska_event_t* event);
+
+// Post a ska_event_user event from any thread.
+// Lets worker threads (asset streaming, networking) hand results to the
+// thread that polls events. A blocked ska_event_wait*() wakes up right away
+// instead of at the next platform event.
+// Events pushed from one thread arrive in order. They go through the event
+// filter and watches like platform events.
+//
+// @param code App-defined value, returned in ska_event_user_t.code
+// @param opt_data1 App-defined pointer, returned as is
+// @param opt_data2 App-defined pointer, returned as is
+// @return true if posted, false if not initialized or too many events are waiting to be handed over
+SKA_API bool ska_event_push_user(int32_t code, void* opt_data1, void* opt_data2);
+
+// Inject typed text as if the user had entered it.
+// Posts ska_event_text_input events for the window with keyboard focus (window_id
+// 0 if none), split at character boundaries to fit ska_event_text_t.text.
+// Same threading rules as ska_event_push().
+//
+// @param utf8 Null-terminated UTF-8 text (required, not NULL)
+// @return true if all of it was queued, false otherwise (check ska_error_get())
+SKA_API bool ska_text_push_utf8(const char* utf8);
+
+// Event queue statistics, see ska_event_get_queue_stats()
+typedef struct ska_event_queue_stats_t {
+	int32_t  capacity;      // Current queue capacity (grows by doubling)
+	int32_t  max_capacity;  // Hard cap the queue may grow to
+	int32_t  count;         // Events currently waiting in the queue
+	int32_t  high_water;    // Most events ever waiting at once
+	uint64_t dropped;       // Events dropped because the queue was full at its hard cap
+	uint64_t coalesced;     // Events merged into the previous queued event of the same kind
+} ska_event_queue_stats_t;
+
+// Get event queue statistics.
+// Useful to size event_queue_capacity in ska_init_ex() and to detect dropped input.
+//
+// @param out_stats Structure to fill (required, not NULL)
+SKA_API void ska_event_get_queue_stats(ska_event_queue_stats_t* out_stats);
+
+// Event filter callback, see ska_event_set_filter()
+//
+// @param event Event about to be queued, timestamps already filled in
+// @param user_data Pointer passed to ska_event_set_filter()
+// @return true to queue the event, false to drop it
+typedef bool (*ska_event_filter_fn)(const ska_event_t* event, void* user_data);
+
+// Event watch callback, see ska_event_add_watch()
+//
+// @param event Event about to be queued, timestamps already filled in
+// @param user_data Pointer passed to ska_event_add_watch()
+typedef void (*ska_event_watch_fn)(const ska_event_t* event, void* user_data);
+
+// Set a filter that sees every event before it is queued.
+// Dropped events never take a queue slot or reach ska_event_poll(). Runs on
+// the thread that produces events: the polling thread, the input thread with
+// ska_init_info_t.input_thread, or the android_main() looper thread on
+// Android. Keep it short, and don't create/destroy windows from inside it.
+// Hooks may set the filter or add/remove watches, themselves included; the
+// change applies from the next event. A hook changed from another thread can
+// still see an event that was already being posted.
+// Keyboard and mouse state queries are updated whether or not the event is kept.
+//
+// @param opt_filter Filter to install, NULL to remove the current one
+// @param opt_user_data Passed through to the filter
+SKA_API void ska_event_set_filter(ska_event_filter_fn opt_filter, void* opt_user_data);
+
+// Add a watch that sees every event the filter lets through, before it is
+// queued. Same thread and reentrancy rules as ska_event_set_filter().
+//
+// @param watch Callback to add (required, not NULL)
+// @param opt_user_data Passed through to the watch
+// @return true on success, false if too many watches are installed
+SKA_API bool ska_event_add_watch(ska_event_watch_fn watch, void* opt_user_data);
+
+// Remove a watch added with ska_event_add_watch(). No-op if not installed.
+//
+// @param watch Callback to remove
+// @param opt_user_data Must match the user_data it was added with
+SKA_API void ska_event_remove_watch(ska_event_watch_fn watch, void* opt_user_data);
+
+// Enable or disable an event type. Disabled types are dropped before the
+// filter and watches run, and backends skip translating them where they can
+// (X11 never translates disabled key, button, wheel or motion input, and
+// skips the rest right after updating window state). All types start enabled.
+// Keyboard and mouse state queries keep tracking disabled input.
+//
+// @param type Event type to change
+// @param enabled false to stop receiving this type
+SKA_API void ska_event_set_enabled(ska_event_ type, bool enabled);
+
+// Check whether an event type is enabled, see ska_event_set_enabled().
+//
+// @param type Event type to check
+// @return true if events of this type are delivered
+SKA_API bool ska_event_is_enabled(ska_event_ type);
+
 // Wait for an event (blocks until event is available).
 // Equivalent to ska_event_wait_timeout(out_event, -1).
-// Polls with 1ms sleep intervals, so CPU-friendly but not perfectly responsive.
+// Sleeps in the OS until input arrives, so an idle app does not wake up.
 //
 // @param out_event Pointer to event structure to fill (required, not NULL)
 // @return true if event was retrieved, false on error
 SKA_API bool ska_event_wait(ska_event_t* out_event);
 
 // Wait for an event with timeout.
-// Busy-waits with ska_event_poll() + ska_time_sleep(1ms) until event or timeout.
+// Blocks on the platform's event source (X connection fd, Win32 message queue,
+// an ALooper on Android) until an event arrives or the timeout expires, with
+// no periodic wakeups.
 // timeout_ms=0 is equivalent to ska_event_poll(), timeout_ms=-1 waits forever.
 //
 // @param out_event Pointer to event structure to fill (required, not NULL)
@@ -581,6 +820,69 @@ SKA_API bool ska_event_wait(ska_event_t* out_event);
 // @return true if event was retrieved, false if timeout expired or error
 SKA_API bool ska_event_wait_timeout(ska_event_t* out_event, int32_t timeout_ms);
 
+// ============================================================================
+// Event Recording and Replay
+// ============================================================================
+
+// Start recording every event returned by ska_event_poll()/ska_event_poll_batch()
+// (and so ska_event_wait*) into a compact binary log, with timestamp_ns and
+// window ids. File dialog, user and timer events are skipped, their pointers
+// don't outlive the session. Replaces any recording already in progress.
+//
+// @param path File to create or overwrite (UTF-8)
+// @return true on success, false on failure (check ska_error_get())
+SKA_API bool ska_record_start(const char* path);
+
+// Stop recording and close the log. Safe to call when not recording (no-op).
+SKA_API void ska_record_stop(void);
+
+// Replay a log written by ska_record_start().
+// While replaying, platform events are not pumped: ska_event_poll() returns the
+// logged events instead, paced by their recorded timestamps divided by speed.
+// Window ids in the log are opaque ids from the recorded session. A recorded id
+// that no longer resolves is given to the window now in the same slot, so
+// create windows in the same order as the recorded session. Replayed events go
+// through the enabled mask and event hooks like live ones, but are not
+// coalesced again. Keyboard and mouse state follow the replayed events.
+// Replay stops by itself at the end of the log. Not available with
+// ska_init_info_t.input_thread or on Android, where events come from another thread.
+//
+// @param path Log file to replay (UTF-8)
+// @param speed Playback rate (1.0 = recorded pace, 2.0 = twice as fast), <= 0 for as fast as the app polls
+// @return true on success, false on failure (check ska_error_get())
+SKA_API bool ska_replay_start(const char* path, float speed);
+
+// Stop replaying and go back to platform events. Safe to call when not replaying (no-op).
+SKA_API void ska_replay_stop(void);
+
+// Check whether a replay is running.
+//
+// @return true until the log is exhausted or ska_replay_stop() is called
+SKA_API bool ska_replay_is_active(void);
+
+// ============================================================================
+// Timers
+// ============================================================================
+
+// Start a timer that delivers ska_event_timer events through the event queue.
+// ska_event_wait*() sleeps until the nearest deadline instead of the app
+// polling the clock, so an idle app with periodic work stays asleep between
+// ticks. Repeating timers keep their phase: a late tick doesn't push the next
+// one back, and ticks missed while the app wasn't polling are folded into one
+// event with expirations > 1. Timers belong to the thread that polls events.
+//
+// @param interval_ns Time until the first tick, and between ticks when repeating
+// @param repeat true to keep ticking until ska_timer_remove(), false to fire once
+// @param opt_user_data Returned in ska_event_timer_t.user_data
+// @return Timer id, or 0 on failure (check ska_error_get())
+SKA_API ska_timer_id_t ska_timer_add(uint64_t interval_ns, bool repeat, void* opt_user_data);
+
+// Stop a timer. A tick already queued is still delivered.
+//
+// @param id Timer from ska_timer_add()
+// @return true if the timer was running, false if it was unknown or a one-shot timer that already fired
+SKA_API bool ska_timer_remove(ska_timer_id_t id);
+
 // ============================================================================
 // Input State Query
 // ============================================================================
@@ -1013,6 +1315,12 @@ SKA_API void ska_file_dialog_free_result(ska_event_file_dialog_t* ref_result);
 // @return Nanoseconds since ska_init() was called
 SKA_API uint64_t ska_time_get_elapsed_ns(void);
 
+// Check whether ska_time_get_elapsed_ns() currently uses the fast clock.
+// See ska_init_info_t.fast_clock.
+//
+// @return true once calibrated, false if not requested, still calibrating, or unsupported
+SKA_API bool ska_time_is_fast_clock(void);
+
 // Get elapsed time in seconds since ska_init().
 // Convenience wrapper: ska_time_get_elapsed_ns() / 1,000,000,000.0
 //
@@ -1025,6 +1333,91 @@ SKA_API double ska_time_get_elapsed_s(void);
 // @param ms Milliseconds to sleep (approximate)
 SKA_API void ska_time_sleep(uint32_t ms);
 
+// Sleep until ska_time_get_elapsed_ns() reaches deadline_ns.
+// Sleeps on an absolute deadline (clock_nanosleep(TIMER_ABSTIME) on Linux and
+// Android, mach_wait_until() on macOS, a high-resolution waitable timer on
+// Win32), so time spent before the call doesn't add up. The OS may still wake
+// late by scheduler slack; spin_ns > 0 stops sleeping that long before the
+// deadline and busy-waits the rest, trading CPU for precision.
+// Returns immediately if deadline_ns has already passed.
+//
+// @param deadline_ns Time to wake, on the ska_time_get_elapsed_ns() clock
+// @param spin_ns Busy-wait margin before the deadline (0 = sleep only, ~200000 is typical)
+SKA_API void ska_time_sleep_until_ns(uint64_t deadline_ns, uint64_t spin_ns);
+
+// Paces a loop to a fixed rate with ska_time_sleep_until_ns().
+// Deadlines advance by exactly one period, so sleep overshoot on one frame
+// doesn't drift the rate. Set up with ska_frame_pacer_init(); the fields after
+// period_ns and spin_ns are read-only statistics.
+typedef struct ska_frame_pacer_t {
+	uint64_t period_ns;        // Target frame time
+	uint64_t spin_ns;          // Passed to ska_time_sleep_until_ns(), may be changed at any time
+	uint64_t next_deadline_ns; // When the next ska_frame_pacer_wait() returns
+
+	uint64_t frames;           // Waits so far
+	uint64_t missed;           // Waits that started more than a period late and resynced
+	uint64_t jitter_ns;        // How late the last wait woke past its deadline
+	uint64_t jitter_max_ns;    // Largest jitter_ns so far
+	uint64_t jitter_avg_ns;    // Mean jitter_ns
+	uint64_t jitter_total_ns;  // Sum of jitter_ns, for jitter_avg_ns
+} ska_frame_pacer_t;
+
+// Initialize a frame pacer.
+//
+// @param out_pacer Pacer to set up (required, not NULL)
+// @param opt_window Window whose refresh rate is the target when rate_hz <= 0 (can be NULL)
+// @param rate_hz Target rate in Hz, <= 0 to use the window's refresh rate (60 if unknown)
+SKA_API void ska_frame_pacer_init(ska_frame_pacer_t* out_pacer, const ska_window_t* opt_window, float rate_hz);
+
+// Sleep until the next frame is due, then update the jitter statistics.
+// If the loop fell more than a full period behind, the schedule restarts from
+// now instead of returning immediately for every missed frame.
+//
+// @param ref_pacer Pacer from ska_frame_pacer_init()
+SKA_API void ska_frame_pacer_wait(ska_frame_pacer_t* ref_pacer);
+
+// Frame statistics gathered between ska_frame_begin() and ska_frame_end().
+// Frame times go into a fixed log-scale histogram (about 6% bucket width),
+// so percentiles are approximate but recording is O(1) with no allocation.
+// Percentiles and averages are 0 until the first frame ends.
+typedef struct ska_frame_stats_t {
+	uint64_t frames;          // Frames ended since init or the last reset
+	uint64_t frame_p50_ns;    // Median begin-to-end frame time
+	uint64_t frame_p95_ns;
+	uint64_t frame_p99_ns;
+	uint64_t frame_max_ns;
+	uint64_t frame_avg_ns;
+	uint64_t frame_last_ns;   // Most recent frame
+
+	float    refresh_rate_hz; // Rate missed_vsync is measured against
+	uint64_t missed_vsync;    // Refreshes skipped: begin-to-begin intervals past 1.5 periods count each extra period
+
+	uint64_t events;          // Events returned by ska_event_poll()/ska_event_wait*() during frames
+	uint32_t events_max;      // Most events in one frame
+	uint64_t pump_ns;         // Time spent pumping platform events during frames
+	uint64_t pump_max_ns;     // Most pump time in one frame
+
+	uint64_t display_round_trips;     // X11 server round trips during frames, from any sk_app call
+	uint32_t display_round_trips_max; // Most in one frame, 0 means frames never wait on the server
+} ska_frame_stats_t;
+
+// Mark the start of a frame, usually right before polling events.
+// Calling it again without ska_frame_end() discards the open frame.
+//
+// @param opt_window Window whose refresh rate missed vsyncs are counted against (can be NULL for 60 Hz)
+SKA_API void ska_frame_begin(const ska_window_t* opt_window);
+
+// Mark the end of the frame opened by ska_frame_begin(), usually right after present.
+SKA_API void ska_frame_end(void);
+
+// Get statistics for every frame since init or ska_frame_stats_reset().
+//
+// @param out_stats Receives the statistics (required, not NULL)
+SKA_API void ska_frame_stats_get(ska_frame_stats_t* out_stats);
+
+// Clear the histogram and counters, for example after loading finishes.
+SKA_API void ska_frame_stats_reset(void);
+
 // ============================================================================
 // Logging
 // ============================================================================
@@ -1046,6 +1439,83 @@ typedef enum ska_log_ {
 // @param ... Format arguments
 SKA_API void ska_log(ska_log_ level, const char* fmt, ...);
 
+// ============================================================================
+// Statistics
+// ============================================================================
+
+// Per-type arrays in ska_stats_t are indexed by ska_event_ value
+#define SKA_STATS_EVENT_TYPES 64
+
+// Counters sk_app keeps about its own work. All are monotonic since
+// ska_init(), except event_queue_high_water which is a peak.
+typedef struct ska_stats_t {
+	uint64_t events_posted[SKA_STATS_EVENT_TYPES];    // Queued for the app
+	uint64_t events_dropped[SKA_STATS_EVENT_TYPES];   // Lost to a full event queue or cross-thread inbox
+	uint64_t events_coalesced[SKA_STATS_EVENT_TYPES]; // Merged into the previous queued event
+	uint64_t event_queue_high_water;                  // Most events ever waiting at once
+	uint64_t text_codepoints_dropped;                 // Lost to a full ska_text_* queue
+
+	uint64_t pump_calls;         // Trips to the platform from ska_event_poll()/ska_event_wait*()
+	uint64_t pump_ns;            // Time spent in them, excluding blocking waits
+	uint64_t display_flushes;    // X11 only: request buffer flushes and syncs sk_app asked for
+	uint64_t display_requests;   // X11 only: requests sent to the X server so far
+	uint64_t display_round_trips; // X11 only: calls that blocked waiting on a server reply
+	uint64_t clipboard_wait_ns;  // Time spent in ska_clipboard_get_text()
+	uint64_t file_bytes_read;    // Read by ska_file_read*() and ska_asset_read*()
+	uint64_t allocations;        // Heap allocations for windows, queue growth, long event text, file, clipboard and timer buffers
+} ska_stats_t;
+
+// Get a snapshot of sk_app's counters.
+// Counters are updated with relaxed atomics, so this is safe to call from any
+// thread, for example a telemetry thread, at the cost of fields not being
+// captured at exactly the same instant.
+//
+// @param out_stats Structure to fill (required, not NULL)
+SKA_API void ska_stats_get(ska_stats_t* out_stats);
+
+// ============================================================================
+// Profiling
+// ============================================================================
+
+// Scoped timing zones, exported as a Chrome trace (chrome://tracing, ui.perfetto.dev).
+// Only built when sk_app is configured with -DSKA_PROFILE=ON, which defines
+// SKA_PROFILE for the library and its users. Otherwise these are macros that
+// expand to nothing, so instrumented code costs nothing in normal builds.
+// Each thread records into its own ring buffer without locks; when a ring
+// wraps, the oldest zones are dropped. sk_app instruments its own event pump,
+// window creation, file and asset reads and clipboard access.
+#ifdef SKA_PROFILE
+
+// Open a zone on the calling thread. Zones nest, close with ska_profile_end().
+//
+// @param name Zone name, stored by pointer so it must outlive the dump (use a string literal)
+SKA_API void ska_profile_begin(const char* name);
+
+// Close the innermost zone opened on the calling thread.
+SKA_API void ska_profile_end(void);
+
+// Name the calling thread in the trace. Threads are shown by index otherwise.
+//
+// @param name Thread name, stored by pointer (use a string literal)
+SKA_API void ska_profile_thread_name(const char* name);
+
+// Write every thread's recorded zones as Chrome trace event JSON.
+// Safe to call while other threads are recording; zones they overwrite
+// during the dump are left out.
+//
+// @param path File path to write (UTF-8)
+// @return true on success, false on error (check ska_error_get())
+SKA_API bool ska_profile_dump(const char* path);
+
+#else
+
+#define ska_profile_begin(name)       ((void)0)
+#define ska_profile_end()             ((void)0)
+#define ska_profile_thread_name(name) ((void)0)
+#define ska_profile_dump(path)        (false)
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
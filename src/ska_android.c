@@ -243,11 +243,26 @@ static uint16_t ska_android_get_modifiers(int32_t meta_state) {
 	return mods;
 }
 
+// Publishes what the looper thread posted and wakes a ska_platform_wait_events()
+// in progress on the user thread. One ALooper_wake() per wait at most, no
+// matter how many batches get committed.
+static void ska_android_commit(void) {
+	ska_post_event_commit();
+
+	ALooper* looper = atomic_load_explicit(&g_ska.android_wait_looper, memory_order_acquire);
+	if (looper && !atomic_exchange(&g_ska.android_wake_pending, true)) {
+		ALooper_wake(looper);
+	}
+}
+
 // Command handler for app lifecycle events
 static void ska_android_handle_cmd(struct android_app* app, int32_t cmd) {
 	ska_event_t event = {0};
 	event.timestamp = (uint32_t)ska_time_get_elapsed_ms();
 
+	// Keeps windows[] stable while we translate
+	ska_window_list_lock();
+
 	switch (cmd) {
 		case APP_CMD_INIT_WINDOW:
 			// Window has been created
@@ -331,6 +346,17 @@ static void ska_android_handle_cmd(struct android_app* app, int32_t cmd) {
 
 						ska_log(ska_log_info, "Android window resized: %dx%d", width, height);
 					}
+
+					// The glue has re-read the configuration, density may have changed
+					float dpi_scale = ska_platform_get_dpi_scale(window);
+					if (dpi_scale != window->dpi_scale) {
+						window->dpi_scale = dpi_scale;
+						event.type = ska_event_window_dpi_changed;
+						event.window.window_id = window->id;
+						event.window.data1     = (int32_t)(dpi_scale * 100.0f + 0.5f);
+						event.window.data2     = 0;
+						ska_post_event(&event);
+					}
 				}
 			}
 			break;
@@ -387,10 +413,14 @@ static void ska_android_handle_cmd(struct android_app* app, int32_t cmd) {
 			ska_log(ska_log_info, "App destroy requested");
 			break;
 	}
+	ska_window_list_unlock();
+
+	// This runs on the looper thread, publish to the user thread right away
+	ska_android_commit();
 }
 
-// Input event handler
-static int32_t ska_android_handle_input(struct android_app* app, AInputEvent* input_event) {
+// Input event translation
+static int32_t ska_android_translate_input(struct android_app* app, AInputEvent* input_event) {
 	if (g_ska.window_count == 0) {
 		return 0;
 	}
@@ -634,6 +664,17 @@ static int32_t ska_android_handle_input(struct android_app* app, AInputEvent* in
 	return 0;
 }
 
+// Input event handler
+static int32_t ska_android_handle_input(struct android_app* app, AInputEvent* input_event) {
+	ska_window_list_lock();
+	int32_t handled = ska_android_translate_input(app, input_event);
+	ska_window_list_unlock();
+
+	// This runs on the looper thread, publish to the user thread right away
+	ska_android_commit();
+	return handled;
+}
+
 bool ska_platform_init(void) {
 	if (!g_ska.android_app) {
 		ska_set_error("android_app not set - call ska_android_set_app() before ska_init()");
@@ -644,6 +685,9 @@ bool ska_platform_init(void) {
 	g_ska.android_app->onAppCmd     = ska_android_handle_cmd;
 	g_ska.android_app->onInputEvent = ska_android_handle_input;
 
+	// Events come from the android_main() looper thread, which commits them
+	g_ska.event_producer_threaded = true;
+
 	// Initialize scancode table
 	ska_init_scancode_table();
 
@@ -658,6 +702,11 @@ bool ska_platform_init(void) {
 void ska_platform_shutdown(void) {
 	ska_jni_cache_shutdown();
 
+	ALooper* looper = atomic_exchange(&g_ska.android_wait_looper, NULL);
+	if (looper) {
+		ALooper_release(looper);
+	}
+
 	if (g_ska.android_app) {
 		g_ska.android_app->onAppCmd     = NULL;
 		g_ska.android_app->onInputEvent = NULL;
@@ -924,6 +973,30 @@ float ska_platform_get_refresh_rate(const ska_window_t* window) {
 	return (float)rate;
 }
 
+int32_t ska_platform_display_count(void) {
+	return 1; // Apps only ever see the display they run on
+}
+
+bool ska_platform_display_get_info(int32_t index, ska_display_info_t* out_info) {
+	if (index != 0) {
+		return false;
+	}
+
+	// The app's window covers the display, minus whatever system bars the
+	// activity keeps, so its size is the best bounds we have without JNI
+	ANativeWindow* native_window = g_ska.android_app ? g_ska.android_app->window : NULL;
+	if (native_window) {
+		out_info->width  = ANativeWindow_getWidth (native_window);
+		out_info->height = ANativeWindow_getHeight(native_window);
+	}
+	out_info->work_width   = out_info->width;
+	out_info->work_height  = out_info->height;
+	out_info->refresh_rate = ska_platform_get_refresh_rate(NULL);
+	out_info->dpi_scale    = ska_platform_get_dpi_scale(NULL);
+	out_info->is_primary   = true;
+	return true;
+}
+
 void ska_platform_warp_mouse(ska_window_t* window, int32_t x, int32_t y) {
 	// Cannot warp cursor on touchscreen
 	(void)window; (void)x; (void)y;
@@ -952,13 +1025,42 @@ void ska_platform_pump_events(void) {
 	// On Android, events are already being pumped by the android_main() loop
 	// in the main thread. The user's main() runs in a separate thread and
 	// consumes events from the thread-safe event queue.
-	// Calling ALooper_pollOnce() here would fail with "No looper for this thread!"
-	// because the user thread doesn't have a looper attached.
+	// The input and command queues are attached to the android_main() looper,
+	// so there is nothing to poll here; ska_platform_wait_events() sleeps on
+	// a looper of the user thread's own.
 
 	// Check for file dialog completion (requires Java helper for full implementation)
 	ska_android_check_file_dialog();
 }
 
+void ska_platform_wait_events(int32_t timeout_ms) {
+	// Events are produced by the android_main() looper thread, which wakes
+	// this thread's own looper after each commit (see ska_android_commit).
+	// The user thread doesn't have a looper until we give it one here.
+	ALooper* looper = atomic_load_explicit(&g_ska.android_wait_looper, memory_order_relaxed);
+	if (!looper) {
+		looper = ALooper_prepare(0);
+		ALooper_acquire(looper);
+		atomic_store_explicit(&g_ska.android_wait_looper, looper, memory_order_release);
+		return; // A commit before the store couldn't wake us, let the caller re-poll
+	}
+
+	// Returns ALOOPER_POLL_WAKE on a commit, ALOOPER_POLL_TIMEOUT otherwise
+	ALooper_pollOnce(timeout_ms < 0 ? -1 : timeout_ms, NULL, NULL, NULL);
+
+	// Clear after waking: a commit racing with this either sees the flag
+	// still set (and the caller's re-poll finds its events) or wakes again
+	atomic_store(&g_ska.android_wake_pending, false);
+}
+
+void ska_platform_wake(void) {
+	// The looper thread drains the inbox, then wakes the user thread once it
+	// has committed the events
+	if (g_ska.android_app && g_ska.android_app->looper) {
+		ALooper_wake(g_ska.android_app->looper);
+	}
+}
+
 /////////////////////////////////////////
 // Android specific subset of Vulkan header
 /////////////////////////////////////////
@@ -1146,6 +1248,9 @@ typedef struct {
 
 static android_main_state_t g_android_main_state = {0};
 
+// Defined with the file dialog code below
+static void ska_android_post_file_dialog_result(void);
+
 // Thread function that runs the user's main()
 static void* ska_android_user_main_thread(void* arg) {
 	(void)arg;
@@ -1154,6 +1259,7 @@ static void* ska_android_user_main_thread(void* arg) {
 	char* argv[] = {"sk_app", NULL};
 	g_android_main_state.user_main_result = main(1, argv);
 	g_android_main_state.user_main_finished = true;
+	ALooper_wake(g_android_main_state.app->looper);
 
 	// Request app destruction when main() returns
 	ANativeActivity_finish(g_android_main_state.app->activity);
@@ -1333,8 +1439,12 @@ void android_main(struct android_app* app) {
 		int32_t events;
 		struct android_poll_source* source;
 
-		// Poll for events (non-blocking since user thread is running)
-		while (ALooper_pollOnce(0, NULL, &events, (void**)&source) >= 0) {
+		// Sleep until input, a lifecycle command or an ALooper_wake() from
+		// ska_platform_wake(), then take whatever else is ready without blocking
+		int32_t timeout_ms = -1;
+		while (ALooper_pollOnce(timeout_ms, NULL, &events, (void**)&source) >= 0) {
+			timeout_ms = 0;
+
 			// Process this event
 			if (source != NULL) {
 				source->process(app, source);
@@ -1350,20 +1460,26 @@ void android_main(struct android_app* app) {
 			}
 		}
 
+		// File dialog results arrive on the Java UI thread
+		ska_android_post_file_dialog_result();
+
+		// Events pushed from other threads, see ska_event_push_user()
+		int32_t inbox_count = ska_post_inbox_events();
+		if (inbox_count > 0) {
+			ska_android_commit();
+		}
+
 		// If user's main finished, exit
 		if (g_android_main_state.user_main_finished) {
 			pthread_join(user_thread, NULL);
 			return;
 		}
-
-		// Small sleep to avoid busy-waiting
-		ska_time_sleep(1);
 	}
 }
 
 // ========== Asset I/O (Android) ==========
 
-SKA_API bool ska_asset_read(const char* asset_name, void** out_data, size_t* out_size) {
+static bool ska_asset_read_impl(const char* asset_name, void** out_data, size_t* out_size) {
 	if (!asset_name) {
 		ska_set_error("ska_asset_read: NULL asset_name");
 		return false;
@@ -1400,9 +1516,13 @@ SKA_API bool ska_asset_read(const char* asset_name, void** out_data, size_t* out
 		AAsset_close(asset);
 		return false;
 	}
+	ska_stats_add(allocations, 1);
 
 	int bytes_read = AAsset_read(asset, data, (size_t)asset_length);
 	AAsset_close(asset);
+	if (bytes_read > 0) {
+		ska_stats_add(file_bytes_read, bytes_read);
+	}
 
 	if (bytes_read != asset_length) {
 		ska_set_error("ska_asset_read: Read %d bytes, expected %ld", bytes_read, (long)asset_length);
@@ -1418,6 +1538,13 @@ SKA_API bool ska_asset_read(const char* asset_name, void** out_data, size_t* out
 	return true;
 }
 
+SKA_API bool ska_asset_read(const char* asset_name, void** out_data, size_t* out_size) {
+	ska_profile_begin("ska_asset_read");
+	bool result = ska_asset_read_impl(asset_name, out_data, out_size);
+	ska_profile_end();
+	return result;
+}
+
 SKA_API bool ska_asset_read_text(const char* asset_name, char** out_text) {
 	if (!asset_name) {
 		ska_set_error("ska_asset_read_text: NULL asset_name");
@@ -1468,9 +1595,14 @@ static struct {
 
 // Pending file dialog state
 typedef struct {
-	ska_file_dialog_id_t id;
-	char*                title;
-	bool                 active;
+	ska_file_dialog_id_t      id;
+	char*                     title;
+	bool                      active;
+	// Set by the JNI callback (Java UI thread), posted by the looper thread so
+	// the event queue keeps a single producer
+	ska_file_dialog_result_t* result;
+	bool                      cancelled;
+	_Atomic bool              completed;
 } ska_android_file_dialog_t;
 
 static ska_android_file_dialog_t g_android_file_dialog = {0};
@@ -1745,18 +1877,34 @@ Java_net_stereokit_sk_1app_SkAppActivity_nativeOnFileDialogResult(
 		}
 	}
 
+	// Hand the result to the looper thread, which posts the event
+	g_android_file_dialog.result    = result;
+	g_android_file_dialog.cancelled = cancelled;
+	atomic_store_explicit(&g_android_file_dialog.completed, true, memory_order_release);
+	ska_platform_wake();
+
+	ska_log(ska_log_info, "File dialog completed: %d paths, cancelled=%d",
+		result->path_count, cancelled);
+}
+
+// Called from the android_main() looper loop, the event producer thread
+static void ska_android_post_file_dialog_result(void) {
+	if (!atomic_load_explicit(&g_android_file_dialog.completed, memory_order_acquire)) {
+		return;
+	}
+	atomic_store_explicit(&g_android_file_dialog.completed, false, memory_order_relaxed);
+
 	// Mark complete and post event
-	ska_file_dialog_result_complete(result, cancelled);
+	ska_file_dialog_result_complete(g_android_file_dialog.result, g_android_file_dialog.cancelled);
+	ska_android_commit();
 
 	// Clear pending state
+	g_android_file_dialog.result = NULL;
 	g_android_file_dialog.active = false;
 	if (g_android_file_dialog.title) {
 		free(g_android_file_dialog.title);
 		g_android_file_dialog.title = NULL;
 	}
-
-	ska_log(ska_log_info, "File dialog completed: %d paths, cancelled=%d",
-		result->path_count, result->cancelled);
 }
 
 #endif // SKA_PLATFORM_ANDROID
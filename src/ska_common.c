@@ -6,6 +6,7 @@
 #include "ska_internal.h"
 #include <stdarg.h>
 #include <time.h>
+#include <errno.h>
 
 #ifdef SKA_PLATFORM_WIN32
 #include <timeapi.h>
@@ -15,6 +16,10 @@
 
 #ifdef SKA_PLATFORM_WIN32
 static LARGE_INTEGER g_qpc_frequency;
+static DWORD         g_sleep_timer_fls = FLS_OUT_OF_INDEXES; // Per-thread ska_time_sleep_until_ns() timer
+
+// Defined with ska_time_sleep_until_ns() below
+static VOID WINAPI ska_win32_sleep_timer_free(PVOID timer);
 #endif
 
 #ifdef SKA_PLATFORM_LINUX
@@ -27,6 +32,17 @@ static LARGE_INTEGER g_qpc_frequency;
 #include <unistd.h>
 #endif
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define SKA_FAST_CLOCK_X86
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#include <cpuid.h>
+#define SKA_FAST_CLOCK_X86
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+#define SKA_FAST_CLOCK_ARM64
+#endif
+
 // Global state
 ska_state_t g_ska = {0};
 
@@ -46,11 +62,39 @@ SKA_API const char* ska_error_get(void) {
 	return g_ska.error_msg[0] != '\0' ? g_ska.error_msg : NULL;
 }
 
+// ============================================================================
+// Memory
+// ============================================================================
+
+void* ska_aligned_alloc(size_t alignment, size_t size) {
+#ifdef SKA_PLATFORM_WIN32
+	return _aligned_malloc(size, alignment);
+#else
+	void* ptr = NULL;
+	return posix_memalign(&ptr, alignment, size) == 0 ? ptr : NULL;
+#endif
+}
+
+void ska_aligned_free(void* ptr) {
+#ifdef SKA_PLATFORM_WIN32
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
 // ============================================================================
 // Initialization
 // ============================================================================
 
+// Defined with the time functions below
+static void ska_fast_clock_init(void);
+
 SKA_API bool ska_init(void) {
+	return ska_init_ex(NULL);
+}
+
+SKA_API bool ska_init_ex(const ska_init_info_t* opt_info) {
 	if (g_ska.initialized) {
 		ska_set_error("sk_app already initialized");
 		return false;
@@ -64,19 +108,37 @@ SKA_API bool ska_init(void) {
 	memset(&g_ska, 0, sizeof(g_ska));
 #ifdef SKA_PLATFORM_WIN32
 	QueryPerformanceFrequency(&g_qpc_frequency);
+	if (g_sleep_timer_fls == FLS_OUT_OF_INDEXES) {
+		g_sleep_timer_fls = FlsAlloc(ska_win32_sleep_timer_free);
+	}
 #endif
 	g_ska.start_time = ska_get_time_ns();
-	g_ska.next_window_id = 1;
 
 #ifdef SKA_PLATFORM_ANDROID
 	// Restore android_app pointer
 	g_ska.android_app = saved_android_app;
 #endif
 
-	ska_event_queue_init(&g_ska.event_queue);
+	ska_init_info_t info = {0};
+	if (opt_info) {
+		info = *opt_info;
+	}
+
+	if (!ska_event_queue_init(&g_ska.event_queue, info.event_queue_capacity, info.event_queue_max_capacity)) {
+		return false;
+	}
+	ska_event_inbox_init(&g_ska.event_inbox);
+	g_ska.event_coalesce_threshold = info.event_coalesce_threshold != 0
+		? info.event_coalesce_threshold
+		: SKA_EVENT_COALESCE_DEFAULT_THRESHOLD;
+	g_ska.input_thread_requested = info.input_thread;
+	if (info.fast_clock) {
+		ska_fast_clock_init();
+	}
 	ska_input_state_init(&g_ska.input_state);
 
 	if (!ska_platform_init()) {
+		ska_event_queue_free(&g_ska.event_queue);
 		return false;
 	}
 
@@ -90,14 +152,25 @@ SKA_API void ska_shutdown(void) {
 		return;
 	}
 
-	// Destroy all windows
-	for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-		if (g_ska.windows[i]) {
-			ska_window_destroy(g_ska.windows[i]);
-		}
+	// Destroy all windows, last first so nothing moves in windows[]
+	while (g_ska.window_count > 0) {
+		ska_window_destroy(g_ska.windows[g_ska.window_count - 1]);
 	}
+	ska_window_registry_free();
+
+	ska_record_stop();
+	ska_replay_stop();
+	ska_timer_clear();
+	ska_frame_clear();
 
 	ska_platform_shutdown();
+	ska_event_queue_free(&g_ska.event_queue);
+#ifdef SKA_PLATFORM_WIN32
+	if (g_sleep_timer_fls != FLS_OUT_OF_INDEXES) {
+		FlsFree(g_sleep_timer_fls);
+		g_sleep_timer_fls = FLS_OUT_OF_INDEXES;
+	}
+#endif
 
 	g_ska.initialized = false;
 	ska_log(ska_log_info, "sk_app shutdown");
@@ -107,47 +180,179 @@ SKA_API void ska_shutdown(void) {
 // Window Management
 // ============================================================================
 
-ska_window_t* ska_window_alloc(void) {
-	if (g_ska.window_count >= SKA_MAX_WINDOWS) {
-		ska_set_error("Maximum number of windows (%d) reached", SKA_MAX_WINDOWS);
-		return NULL;
+// ========== Registry ==========
+//
+// Windows live in three tables, all guarded by window_list_lock and all
+// growable: windows[] packed for iteration (removal swaps the last one in),
+// window_slots indexed by the low bits of an id, and window_natives, an open
+// addressing table from OS handle to window. Lookups never scan.
+
+// Doubles *ref_array until it holds min_count items
+static bool ska_registry_reserve(void** ref_array, uint32_t* ref_capacity, uint32_t min_count, size_t item_size) {
+	if (min_count <= *ref_capacity) {
+		return true;
+	}
+	uint32_t capacity = *ref_capacity > 0 ? *ref_capacity : 16;
+	while (capacity < min_count) {
+		capacity *= 2;
+	}
+	void* array = realloc(*ref_array, capacity * item_size);
+	if (!array) {
+		return false;
+	}
+	ska_stats_add(allocations, 1);
+	*ref_array    = array;
+	*ref_capacity = capacity;
+	return true;
+}
+
+static uint32_t ska_native_bucket(uintptr_t handle, uint32_t capacity) {
+	// Fibonacci hashing spreads pointer-aligned and sequential XIDs alike
+	uint64_t hash = (uint64_t)handle * 0x9E3779B97F4A7C15ULL;
+	return (uint32_t)(hash >> 32) & (capacity - 1);
+}
+
+static void ska_native_insert(ska_window_native_t* natives, uint32_t capacity, uintptr_t handle, ska_window_t* window) {
+	uint32_t bucket = ska_native_bucket(handle, capacity);
+	while (natives[bucket].handle != 0 && natives[bucket].handle != handle) {
+		bucket = (bucket + 1) & (capacity - 1);
+	}
+	natives[bucket].handle = handle;
+	natives[bucket].window = window;
+}
+
+static bool ska_native_add(uintptr_t handle, ska_window_t* window) {
+	// Kept at most 3/4 full so probe runs stay short
+	if ((g_ska.window_native_count + 1) * 4 > g_ska.window_native_capacity * 3) {
+		uint32_t capacity = g_ska.window_native_capacity > 0 ? g_ska.window_native_capacity * 2 : 32;
+		ska_window_native_t* natives = (ska_window_native_t*)calloc(capacity, sizeof(ska_window_native_t));
+		if (!natives) {
+			return false;
+		}
+		ska_stats_add(allocations, 1);
+		for (uint32_t i = 0; i < g_ska.window_native_capacity; i++) {
+			if (g_ska.window_natives[i].handle != 0) {
+				ska_native_insert(natives, capacity, g_ska.window_natives[i].handle, g_ska.window_natives[i].window);
+			}
+		}
+		free(g_ska.window_natives);
+		g_ska.window_natives         = natives;
+		g_ska.window_native_capacity = capacity;
+	}
+	ska_native_insert(g_ska.window_natives, g_ska.window_native_capacity, handle, window);
+	g_ska.window_native_count++;
+	return true;
+}
+
+static void ska_native_remove(uintptr_t handle) {
+	if (g_ska.window_native_capacity == 0) {
+		return;
+	}
+	uint32_t mask   = g_ska.window_native_capacity - 1;
+	uint32_t bucket = ska_native_bucket(handle, g_ska.window_native_capacity);
+	while (g_ska.window_natives[bucket].handle != handle) {
+		if (g_ska.window_natives[bucket].handle == 0) {
+			return;
+		}
+		bucket = (bucket + 1) & mask;
 	}
 
+	// Shift later members of the probe run back so no tombstones are needed
+	uint32_t hole = bucket;
+	for (uint32_t next = (hole + 1) & mask; g_ska.window_natives[next].handle != 0; next = (next + 1) & mask) {
+		uint32_t home = ska_native_bucket(g_ska.window_natives[next].handle, g_ska.window_native_capacity);
+		// Movable unless its home lies cyclically in (hole, next]
+		if (((next - home) & mask) >= ((next - hole) & mask)) {
+			g_ska.window_natives[hole] = g_ska.window_natives[next];
+			hole = next;
+		}
+	}
+	g_ska.window_natives[hole].handle = 0;
+	g_ska.window_natives[hole].window = NULL;
+	g_ska.window_native_count--;
+}
+
+void ska_window_registry_free(void) {
+	free(g_ska.windows);
+	free(g_ska.window_slots);
+	free(g_ska.window_natives);
+	g_ska.windows                = NULL;
+	g_ska.window_count           = 0;
+	g_ska.window_capacity        = 0;
+	g_ska.window_slots           = NULL;
+	g_ska.window_slot_count      = 0;
+	g_ska.window_slot_capacity   = 0;
+	g_ska.window_slot_free       = 0;
+	g_ska.window_natives         = NULL;
+	g_ska.window_native_count    = 0;
+	g_ska.window_native_capacity = 0;
+}
+
+ska_window_t* ska_window_alloc(void) {
 	ska_window_t* window = (ska_window_t*)calloc(1, sizeof(ska_window_t));
 	if (!window) {
 		ska_set_error("Failed to allocate window structure");
 		return NULL;
 	}
-
-	window->id = g_ska.next_window_id++;
+	ska_stats_add(allocations, 1);
 	window->is_visible = true;
 
-	// Find free slot
-	for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-		if (!g_ska.windows[i]) {
-			g_ska.windows[i] = window;
-			g_ska.window_count++;
-			return window;
-		}
+	ska_window_list_lock();
+	uint32_t slot = g_ska.window_slot_free > 0 ? g_ska.window_slot_free - 1 : g_ska.window_slot_count;
+	if (slot >= SKA_WINDOW_SLOT_MASK) {
+		ska_window_list_unlock();
+		free(window);
+		ska_set_error("Maximum number of windows (%u) reached", SKA_WINDOW_SLOT_MASK);
+		return NULL;
+	}
+	if (!ska_registry_reserve((void**)&g_ska.window_slots, &g_ska.window_slot_capacity, slot + 1,              sizeof(ska_window_slot_t)) ||
+	    !ska_registry_reserve((void**)&g_ska.windows,      &g_ska.window_capacity,      g_ska.window_count + 1, sizeof(ska_window_t*))) {
+		ska_window_list_unlock();
+		free(window);
+		ska_set_error("Failed to grow the window list");
+		return NULL;
 	}
 
-	free(window);
-	ska_set_error("Internal error: no free window slot");
-	return NULL;
+	if (slot == g_ska.window_slot_count) {
+		g_ska.window_slots[slot].generation = 0;
+		g_ska.window_slot_count++;
+	} else {
+		g_ska.window_slot_free = g_ska.window_slots[slot].next_free;
+	}
+	ska_window_slot_t* entry = &g_ska.window_slots[slot];
+	entry->window    = window;
+	entry->next_free = 0;
+
+	window->id         = ((entry->generation & SKA_WINDOW_SLOT_MASK) << SKA_WINDOW_SLOT_BITS) | (slot + 1);
+	window->list_index = g_ska.window_count;
+	g_ska.windows[g_ska.window_count++] = window;
+	ska_window_list_unlock();
+
+	return window;
 }
 
 void ska_window_free(ska_window_t* ref_window) {
 	if (!ref_window) return;
 
-	// Remove from window array
-	for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-		if (g_ska.windows[i] == ref_window) {
-			g_ska.windows[i] = NULL;
-			g_ska.window_count--;
-			break;
-		}
+	ska_window_list_lock();
+	if (ref_window->native_handle != 0) {
+		ska_native_remove(ref_window->native_handle);
+		ref_window->native_handle = 0;
 	}
 
+	// Retire the id and put the slot on the free list
+	ska_window_slot_t* entry = &g_ska.window_slots[(ref_window->id & SKA_WINDOW_SLOT_MASK) - 1];
+	entry->window    = NULL;
+	entry->generation++;
+	entry->next_free = g_ska.window_slot_free;
+	g_ska.window_slot_free = ref_window->id & SKA_WINDOW_SLOT_MASK;
+
+	// Fill the gap in windows[] with the last window
+	ska_window_t* last = g_ska.windows[--g_ska.window_count];
+	g_ska.windows[ref_window->list_index] = last;
+	last->list_index = ref_window->list_index;
+	ska_window_list_unlock();
+
 	if (ref_window->title) {
 		free(ref_window->title);
 	}
@@ -155,6 +360,48 @@ void ska_window_free(ska_window_t* ref_window) {
 	free(ref_window);
 }
 
+void ska_window_set_native(ska_window_t* ref_window, uintptr_t handle) {
+	ska_window_list_lock();
+	if (ref_window->native_handle != 0) {
+		ska_native_remove(ref_window->native_handle);
+		ref_window->native_handle = 0;
+	}
+	if (handle != 0) {
+		if (ska_native_add(handle, ref_window)) {
+			ref_window->native_handle = handle;
+		} else {
+			ska_log(ska_log_error, "Out of memory registering window %u, its events will be dropped", ref_window->id);
+		}
+	}
+	ska_window_list_unlock();
+}
+
+ska_window_t* ska_window_from_native(uintptr_t handle) {
+	if (handle == 0 || g_ska.window_native_capacity == 0) {
+		return NULL;
+	}
+	uint32_t mask   = g_ska.window_native_capacity - 1;
+	uint32_t bucket = ska_native_bucket(handle, g_ska.window_native_capacity);
+	while (g_ska.window_natives[bucket].handle != 0) {
+		if (g_ska.window_natives[bucket].handle == handle) {
+			return g_ska.window_natives[bucket].window;
+		}
+		bucket = (bucket + 1) & mask;
+	}
+	return NULL;
+}
+
+void ska_window_list_lock(void) {
+	// Only ever contended by a backend input thread translating one event
+	while (atomic_flag_test_and_set_explicit(&g_ska.window_list_lock, memory_order_acquire)) {
+		ska_time_sleep(0);
+	}
+}
+
+void ska_window_list_unlock(void) {
+	atomic_flag_clear_explicit(&g_ska.window_list_lock, memory_order_release);
+}
+
 SKA_API ska_window_t* ska_window_create(
 	const char* title,
 	int32_t x, int32_t y,
@@ -194,7 +441,9 @@ SKA_API ska_window_t* ska_window_create(
 	window->x = x;
 	window->y = y;
 
+	ska_profile_begin("ska_window_create");
 	if (!ska_platform_window_create(window, title, x, y, width, height, flags)) {
+		ska_profile_end();
 		ska_window_free(window);
 		return NULL;
 	}
@@ -202,6 +451,7 @@ SKA_API ska_window_t* ska_window_create(
 	if (!(flags & ska_window_hidden)) {
 		ska_platform_window_show(window);
 	}
+	ska_profile_end();
 
 	return window;
 }
@@ -218,12 +468,13 @@ SKA_API ska_window_id_t ska_window_get_id(const ska_window_t* window) {
 }
 
 SKA_API ska_window_t* ska_window_from_id(ska_window_id_t id) {
-	for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-		if (g_ska.windows[i] && g_ska.windows[i]->id == id) {
-			return g_ska.windows[i];
-		}
+	// The slot gives the candidate, the full id comparison rejects stale generations
+	uint32_t slot = id & SKA_WINDOW_SLOT_MASK;
+	if (slot == 0 || slot > g_ska.window_slot_count) {
+		return NULL;
 	}
-	return NULL;
+	ska_window_t* window = g_ska.window_slots[slot - 1].window;
+	return window && window->id == id ? window : NULL;
 }
 
 SKA_API void ska_window_set_title(ska_window_t* ref_window, const char* title) {
@@ -311,13 +562,35 @@ SKA_API void ska_window_get_drawable_size(ska_window_t* ref_window, int32_t* opt
 
 SKA_API float ska_window_get_dpi_scale(const ska_window_t* window) {
 	if (!window) return 1.0f;
-	return ska_platform_get_dpi_scale(window);
+	return window->dpi_scale;
 }
 
 SKA_API float ska_window_get_refresh_rate(const ska_window_t* window) {
 	return ska_platform_get_refresh_rate(window);
 }
 
+SKA_API int32_t ska_display_count(void) {
+	if (!g_ska.initialized) return 0;
+	return ska_platform_display_count();
+}
+
+SKA_API bool ska_display_get_info(int32_t index, ska_display_info_t* out_info) {
+	if (!out_info) {
+		ska_set_error("ska_display_get_info: NULL out_info");
+		return false;
+	}
+	memset(out_info, 0, sizeof(*out_info));
+	if (!g_ska.initialized) {
+		ska_set_error("ska_display_get_info: sk_app not initialized");
+		return false;
+	}
+	if (!ska_platform_display_get_info(index, out_info)) {
+		ska_set_error("ska_display_get_info: Invalid display index %d", index);
+		return false;
+	}
+	return true;
+}
+
 SKA_API void ska_window_show(ska_window_t* ref_window) {
 	if (!ref_window) return;
 	ska_platform_window_show(ref_window);
@@ -372,9 +645,346 @@ SKA_API void* ska_window_get_native_handle(const ska_window_t* window) {
 // Event System
 // ============================================================================
 
+// Events that only describe the latest state, so several in a row can be
+// merged into one and, under pressure, dropped without leaving stale state.
+static bool ska_event_is_coalescable(ska_event_ type) {
+	return type == ska_event_mouse_motion   ||
+	       type == ska_event_mouse_wheel    ||
+	       type == ska_event_window_resized ||
+	       type == ska_event_window_moved;
+}
+
+// Try to fold event into the newest queued event. Resize/move always merge
+// (only the final geometry matters), motion and wheel only once the queue is
+// backing up, since some apps want every motion sample.
+static bool ska_event_coalesce(ska_queued_event_t* ref_last, const ska_event_t* event, uint64_t timestamp_ns) {
+	if (ref_last->type != (uint8_t)event->type) {
+		return false;
+	}
+
+	switch (event->type) {
+	case ska_event_window_resized:
+	case ska_event_window_moved:
+		if (ref_last->window_id != event->window.window_id) return false;
+		ref_last->window.data1 = event->window.data1;
+		ref_last->window.data2 = event->window.data2;
+		break;
+
+	case ska_event_mouse_motion:
+		if (ref_last->window_id != event->mouse_motion.window_id) return false;
+		ref_last->mouse_motion.x     = event->mouse_motion.x;
+		ref_last->mouse_motion.y     = event->mouse_motion.y;
+		ref_last->mouse_motion.xrel += event->mouse_motion.xrel;
+		ref_last->mouse_motion.yrel += event->mouse_motion.yrel;
+		break;
+
+	case ska_event_mouse_wheel:
+		if (ref_last->window_id != event->mouse_wheel.window_id) return false;
+		ref_last->mouse_wheel.x         += event->mouse_wheel.x;
+		ref_last->mouse_wheel.y         += event->mouse_wheel.y;
+		ref_last->mouse_wheel.precise_x += event->mouse_wheel.precise_x;
+		ref_last->mouse_wheel.precise_y += event->mouse_wheel.precise_y;
+		break;
+
+	default:
+		return false;
+	}
+
+	ref_last->timestamp_ns = timestamp_ns;
+	return true;
+}
+
+// The hook lock is only held to read or change the hooks, never while they
+// run, so a hook can install or remove hooks (itself included)
+static void ska_event_hook_lock(void) {
+	while (atomic_flag_test_and_set_explicit(&g_ska.event_hook_lock, memory_order_acquire)) {
+		ska_time_sleep(0);
+	}
+}
+
+static void ska_event_hook_unlock(void) {
+	atomic_flag_clear_explicit(&g_ska.event_hook_lock, memory_order_release);
+}
+
+// Caller holds the hook lock
+static void ska_event_hooks_changed(void) {
+	atomic_store_explicit(&g_ska.event_hooked,
+		g_ska.event_filter != NULL || g_ska.event_watch_count > 0, memory_order_relaxed);
+}
+
+// Runs the filter and watches, returns false if the filter dropped the event
+static bool ska_event_run_hooks(const ska_event_t* event, uint64_t timestamp_ns) {
+	// Call from a snapshot, changes a hook makes take effect on the next event
+	ska_event_watch_t watches[SKA_MAX_EVENT_WATCHES];
+	ska_event_hook_lock();
+	ska_event_filter_fn filter      = g_ska.event_filter;
+	void*               filter_user = g_ska.event_filter_user;
+	int32_t             watch_count = g_ska.event_watch_count;
+	memcpy(watches, g_ska.event_watches, (size_t)watch_count * sizeof(watches[0]));
+	ska_event_hook_unlock();
+
+	// Hooks see the event as it will be polled
+	ska_event_t stamped  = *event;
+	stamped.timestamp_ns = timestamp_ns;
+	stamped.timestamp    = (uint32_t)(timestamp_ns / 1000000ULL);
+
+	if (filter && !filter(&stamped, filter_user)) {
+		return false;
+	}
+	for (int32_t i = 0; i < watch_count; i++) {
+		watches[i].fn(&stamped, watches[i].user_data);
+	}
+	return true;
+}
+
+// Shared by live and replayed posts. Replayed events already went through
+// coalescing when they were recorded, so they skip it and are never dropped for
+// being coalescable. Returns false only when the queue was full.
+static bool ska_post_event_queued(const ska_event_t* event, bool replayed) {
+	if (!ska_event_type_enabled(event->type)) {
+		return true;
+	}
+
+	ska_event_queue_t* queue       = &g_ska.event_queue;
+	bool               coalescable = ska_event_is_coalescable(event->type);
+
+	// Backends that know when the input happened fill timestamp_ns, everything
+	// else is stamped now. The millisecond field is derived from it on pop.
+	uint64_t timestamp_ns = event->timestamp_ns != 0 ? event->timestamp_ns : ska_time_get_elapsed_ns();
+
+	if (atomic_load_explicit(&g_ska.event_hooked, memory_order_relaxed) && !ska_event_run_hooks(event, timestamp_ns)) {
+		return true;
+	}
+
+	if (coalescable && !replayed) {
+		ska_queued_event_t* last = ska_event_queue_peek_staged(queue);
+		bool always = event->type == ska_event_window_resized || event->type == ska_event_window_moved;
+		bool under_pressure = g_ska.event_coalesce_threshold >= 0 &&
+			ska_event_queue_count(queue) >= g_ska.event_coalesce_threshold;
+		if (last && (always || under_pressure) && ska_event_coalesce(last, event, timestamp_ns)) {
+			atomic_fetch_add_explicit(&queue->coalesced, 1, memory_order_relaxed);
+			ska_stats_add_owned(events_coalesced[event->type], 1); // Coalescable types are all < 64
+			return true;
+		}
+	}
+
+	bool counted = (uint32_t)event->type < SKA_STATS_EVENT_TYPES;
+	if (ska_event_queue_push(queue, event, timestamp_ns, !coalescable || replayed)) {
+		g_ska.event_queue_overflowing = false;
+		if (counted) ska_stats_add_owned(events_posted[event->type], 1);
+		return true;
+	}
+
+	if (counted) ska_stats_add(events_dropped[event->type], 1);
+	if (!g_ska.event_queue_overflowing) {
+		// Only warn when an overflow starts, a flood would otherwise log per event
+		g_ska.event_queue_overflowing = true;
+		ska_log(ska_log_warn, "Event queue full (%d events), dropping event type %d",
+			ska_event_queue_count(queue), event->type);
+	}
+	return false;
+}
+
 void ska_post_event(const ska_event_t* event) {
-	if (!ska_event_queue_push(&g_ska.event_queue, event)) {
-		ska_log(ska_log_warn, "Event queue full, dropping event type %d", event->type);
+	ska_post_event_queued(event, false);
+}
+
+bool ska_post_replayed_event(const ska_event_t* event) {
+	return ska_post_event_queued(event, true);
+}
+
+void ska_post_event_commit(void) {
+	ska_event_queue_commit(&g_ska.event_queue);
+}
+
+int32_t ska_post_inbox_events(void) {
+	// Bounded so a thread pushing nonstop can't keep the producer here forever
+	ska_event_t event;
+	int32_t     count = 0;
+	while (count < SKA_EVENT_INBOX_SIZE && ska_event_inbox_pop(&g_ska.event_inbox, &event)) {
+		ska_post_event(&event);
+		count++;
+	}
+	return count;
+}
+
+// Hands event to the event producer thread, stamped now so it sorts by when it
+// was pushed rather than when the producer got to it
+static bool ska_event_push_inbox(const ska_event_t* event) {
+	ska_event_t stamped = *event;
+	if (stamped.timestamp_ns == 0) {
+		stamped.timestamp_ns = ska_time_get_elapsed_ns();
+	}
+	if (!ska_event_inbox_push(&g_ska.event_inbox, &stamped)) {
+		if ((uint32_t)stamped.type < SKA_STATS_EVENT_TYPES) {
+			ska_stats_add(events_dropped[stamped.type], 1);
+		}
+		return false;
+	}
+	ska_platform_wake();
+	return true;
+}
+
+SKA_API bool ska_event_push_user(int32_t code, void* opt_data1, void* opt_data2) {
+	// No ska_set_error() here, the error buffer belongs to the app thread
+	if (!g_ska.initialized) {
+		return false;
+	}
+
+	ska_event_t event = {0};
+	event.type       = ska_event_user;
+	event.user.code  = code;
+	event.user.data1 = opt_data1;
+	event.user.data2 = opt_data2;
+	return ska_event_push_inbox(&event);
+}
+
+SKA_API void ska_event_set_filter(ska_event_filter_fn opt_filter, void* opt_user_data) {
+	ska_event_hook_lock();
+	g_ska.event_filter      = opt_filter;
+	g_ska.event_filter_user = opt_user_data;
+	ska_event_hooks_changed();
+	ska_event_hook_unlock();
+}
+
+SKA_API bool ska_event_add_watch(ska_event_watch_fn watch, void* opt_user_data) {
+	if (!watch) {
+		ska_set_error("ska_event_add_watch: NULL watch");
+		return false;
+	}
+
+	ska_event_hook_lock();
+	bool added = g_ska.event_watch_count < SKA_MAX_EVENT_WATCHES;
+	if (added) {
+		g_ska.event_watches[g_ska.event_watch_count].fn        = watch;
+		g_ska.event_watches[g_ska.event_watch_count].user_data = opt_user_data;
+		g_ska.event_watch_count++;
+		ska_event_hooks_changed();
+	}
+	ska_event_hook_unlock();
+
+	if (!added) {
+		ska_set_error("ska_event_add_watch: Maximum watches (%d) reached", SKA_MAX_EVENT_WATCHES);
+	}
+	return added;
+}
+
+SKA_API void ska_event_remove_watch(ska_event_watch_fn watch, void* opt_user_data) {
+	ska_event_hook_lock();
+	for (int32_t i = 0; i < g_ska.event_watch_count; i++) {
+		if (g_ska.event_watches[i].fn == watch && g_ska.event_watches[i].user_data == opt_user_data) {
+			// Keep the rest in the order they were added
+			memmove(&g_ska.event_watches[i], &g_ska.event_watches[i + 1],
+				(size_t)(g_ska.event_watch_count - i - 1) * sizeof(g_ska.event_watches[0]));
+			g_ska.event_watch_count--;
+			ska_event_hooks_changed();
+			break;
+		}
+	}
+	ska_event_hook_unlock();
+}
+
+SKA_API void ska_event_set_enabled(ska_event_ type, bool enabled) {
+	if ((uint32_t)type >= 64) {
+		return; // Outside the mask, always enabled
+	}
+	uint64_t bit = 1ULL << (uint32_t)type;
+	if (enabled) {
+		atomic_fetch_and_explicit(&g_ska.event_disabled, ~bit, memory_order_relaxed);
+	} else {
+		atomic_fetch_or_explicit(&g_ska.event_disabled, bit, memory_order_relaxed);
+	}
+}
+
+SKA_API bool ska_event_is_enabled(ska_event_ type) {
+	return ska_event_type_enabled(type);
+}
+
+SKA_API bool ska_event_push(const ska_event_t* event) {
+	if (!g_ska.initialized || !event) {
+		ska_set_error("ska_event_push: Not initialized or NULL event");
+		return false;
+	}
+	if (g_ska.event_producer_threaded) {
+		if (!ska_event_push_inbox(event)) {
+			ska_set_error("ska_event_push: Too many events waiting for the event thread, event dropped");
+			return false;
+		}
+		return true;
+	}
+
+	uint64_t dropped = atomic_load_explicit(&g_ska.event_queue.dropped, memory_order_relaxed);
+	ska_post_event(event);
+	if (atomic_load_explicit(&g_ska.event_queue.dropped, memory_order_relaxed) != dropped) {
+		ska_set_error("ska_event_push: Event queue full, event dropped");
+		return false;
+	}
+	return true;
+}
+
+SKA_API bool ska_text_push_utf8(const char* utf8) {
+	if (!utf8) {
+		ska_set_error("ska_text_push_utf8: NULL text");
+		return false;
+	}
+
+	ska_event_t event = {0};
+	event.type = ska_event_text_input;
+	for (uint32_t i = 0; i < g_ska.window_count; i++) {
+		if (g_ska.windows[i]->has_focus) {
+			event.text.window_id = g_ska.windows[i]->id;
+			break;
+		}
+	}
+
+	size_t remaining = strlen(utf8);
+	while (remaining > 0) {
+		// Back off to a lead byte so no character is split across events
+		size_t length = remaining < sizeof(event.text.text) - 1 ? remaining : sizeof(event.text.text) - 1;
+		while (length < remaining && length > 0 && ((unsigned char)utf8[length] & 0xC0) == 0x80) {
+			length--;
+		}
+		if (length == 0) {
+			ska_set_error("ska_text_push_utf8: Invalid UTF-8");
+			return false;
+		}
+
+		memset(event.text.text, 0, sizeof(event.text.text));
+		memcpy(event.text.text, utf8, length);
+		if (!ska_event_push(&event)) {
+			return false;
+		}
+
+		utf8      += length;
+		remaining -= length;
+	}
+	return true;
+}
+
+// Fills the queue from the platform (or the replay log), due timers and the
+// inbox. A threaded backend reads the platform and the inbox on its own thread
+// and commits itself.
+static void ska_event_pump(void) {
+	uint64_t start_ns = ska_time_get_elapsed_ns();
+
+	if (g_ska.replaying) {
+		ska_replay_pump();
+	} else {
+		ska_profile_begin("ska_platform_pump_events");
+		ska_platform_pump_events();
+		ska_profile_end();
+	}
+	ska_timer_pump();
+	if (!g_ska.event_producer_threaded) {
+		ska_post_inbox_events();
+		ska_post_event_commit();
+	}
+
+	uint64_t pump_ns = ska_time_get_elapsed_ns() - start_ns;
+	ska_stats_add_owned(pump_calls, 1);
+	ska_stats_add_owned(pump_ns, pump_ns);
+	if (g_ska.frame_open) {
+		g_ska.frame_pump_ns += pump_ns;
 	}
 }
 
@@ -383,10 +993,24 @@ SKA_API bool ska_event_poll(ska_event_t* out_event) {
 		return false;
 	}
 
-	// Process platform events first
-	ska_platform_pump_events();
+	// Only go to the platform once everything already queued has been handed
+	// out, otherwise draining N events costs N pumps (and N XPending calls)
+	if (ska_event_queue_is_empty(&g_ska.event_queue)) {
+		ska_event_pump();
+	} else {
+		// Timers are checked on every call, or a queue that never empties under
+		// continuous input would keep them from firing
+		ska_timer_pump();
+		if (!g_ska.event_producer_threaded) {
+			ska_post_event_commit();
+		}
+	}
 
 	bool has_event = ska_event_queue_pop(&g_ska.event_queue, out_event);
+	g_ska.frame_events += has_event ? 1 : 0;
+	if (has_event && g_ska.recording) {
+		ska_record_events(out_event, 1);
+	}
 
 	// Feed text input events to the text queue
 	if (has_event && out_event->type == ska_event_text_input) {
@@ -396,6 +1020,61 @@ SKA_API bool ska_event_poll(ska_event_t* out_event) {
 	return has_event;
 }
 
+SKA_API int32_t ska_event_poll_batch(ska_event_t* out_events, int32_t max_events) {
+	if (!g_ska.initialized || !out_events || max_events <= 0) {
+		return 0;
+	}
+
+	ska_event_pump();
+
+	int32_t count = ska_event_queue_pop_batch(&g_ska.event_queue, out_events, max_events);
+	g_ska.frame_events += (uint32_t)count;
+	if (count > 0 && g_ska.recording) {
+		ska_record_events(out_events, count);
+	}
+
+	for (int32_t i = 0; i < count; i++) {
+		if (out_events[i].type == ska_event_text_input) {
+			ska_text_queue_push_utf8(&g_ska.input_state.text_queue, out_events[i].text.text);
+		}
+	}
+
+	return count;
+}
+
+SKA_API void ska_stats_get(ska_stats_t* out_stats) {
+	if (!out_stats) return;
+
+	ska_stats_counters_t* stats = &g_ska.stats;
+	for (uint32_t i = 0; i < SKA_STATS_EVENT_TYPES; i++) {
+		out_stats->events_posted[i]    = atomic_load_explicit(&stats->events_posted[i],    memory_order_relaxed);
+		out_stats->events_dropped[i]   = atomic_load_explicit(&stats->events_dropped[i],   memory_order_relaxed);
+		out_stats->events_coalesced[i] = atomic_load_explicit(&stats->events_coalesced[i], memory_order_relaxed);
+	}
+	out_stats->event_queue_high_water  = atomic_load_explicit(&g_ska.event_queue.high_water,     memory_order_relaxed);
+	out_stats->text_codepoints_dropped = atomic_load_explicit(&stats->text_codepoints_dropped, memory_order_relaxed);
+	out_stats->pump_calls              = atomic_load_explicit(&stats->pump_calls,              memory_order_relaxed);
+	out_stats->pump_ns                 = atomic_load_explicit(&stats->pump_ns,                 memory_order_relaxed);
+	out_stats->display_flushes         = atomic_load_explicit(&stats->display_flushes,         memory_order_relaxed);
+	out_stats->display_requests        = atomic_load_explicit(&stats->display_requests,        memory_order_relaxed);
+	out_stats->display_round_trips     = atomic_load_explicit(&stats->display_round_trips,     memory_order_relaxed);
+	out_stats->clipboard_wait_ns       = atomic_load_explicit(&stats->clipboard_wait_ns,       memory_order_relaxed);
+	out_stats->file_bytes_read         = atomic_load_explicit(&stats->file_bytes_read,         memory_order_relaxed);
+	out_stats->allocations             = atomic_load_explicit(&stats->allocations,             memory_order_relaxed);
+}
+
+SKA_API void ska_event_get_queue_stats(ska_event_queue_stats_t* out_stats) {
+	if (!out_stats) return;
+
+	ska_event_queue_t* queue = &g_ska.event_queue;
+	out_stats->capacity     = (int32_t)atomic_load_explicit(&queue->capacity,   memory_order_relaxed);
+	out_stats->max_capacity = (int32_t)queue->max_capacity;
+	out_stats->count        = ska_event_queue_count(queue);
+	out_stats->high_water   = (int32_t)atomic_load_explicit(&queue->high_water, memory_order_relaxed);
+	out_stats->dropped      = atomic_load_explicit(&queue->dropped,   memory_order_relaxed);
+	out_stats->coalesced    = atomic_load_explicit(&queue->coalesced, memory_order_relaxed);
+}
+
 SKA_API bool ska_event_wait(ska_event_t* out_event) {
 	return ska_event_wait_timeout(out_event, -1);
 }
@@ -405,7 +1084,7 @@ SKA_API bool ska_event_wait_timeout(ska_event_t* out_event, int32_t timeout_ms)
 		return false;
 	}
 
-	uint64_t start = ska_time_get_elapsed_ms();
+	uint64_t start_ns = ska_time_get_elapsed_ns();
 
 	while (true) {
 		if (ska_event_poll(out_event)) {
@@ -416,14 +1095,40 @@ SKA_API bool ska_event_wait_timeout(ska_event_t* out_event, int32_t timeout_ms)
 			return false;
 		}
 
+		// Block in the platform layer for the remaining time, rounded up so we
+		// never wake a fraction of a millisecond early and spin.
+		int32_t remaining_ms = -1;
 		if (timeout_ms > 0) {
-			uint64_t elapsed = ska_time_get_elapsed_ms() - start;
-			if (elapsed >= (uint64_t)timeout_ms) {
+			uint64_t elapsed_ns = ska_time_get_elapsed_ns() - start_ns;
+			uint64_t timeout_ns = (uint64_t)timeout_ms * 1000000ULL;
+			if (elapsed_ns >= timeout_ns) {
 				return false;
 			}
+			remaining_ms = (int32_t)((timeout_ns - elapsed_ns + 999999ULL) / 1000000ULL);
 		}
 
-		ska_time_sleep(1);
+		// Wake in time for the next timer, rounded up so it is due by then
+		uint64_t timer_ns = ska_timer_next_deadline_ns();
+		if (timer_ns != UINT64_MAX) {
+			uint64_t now_ns   = ska_time_get_elapsed_ns();
+			uint64_t timer_ms = timer_ns > now_ns ? (timer_ns - now_ns + 999999ULL) / 1000000ULL : 0;
+			if (timer_ms < (uint64_t)INT32_MAX && (remaining_ms < 0 || timer_ms < (uint64_t)remaining_ms)) {
+				remaining_ms = (int32_t)timer_ms;
+			}
+		}
+
+		// Replay doesn't pump the platform, so waiting on it would either
+		// oversleep the next replayed event or spin on unread platform input
+		if (g_ska.replaying) {
+			int32_t replay_ms = ska_replay_wait_ms();
+			if (remaining_ms < 0 || replay_ms < remaining_ms) {
+				remaining_ms = replay_ms;
+			}
+			ska_time_sleep((uint32_t)remaining_ms);
+			continue;
+		}
+
+		ska_platform_wait_events(remaining_ms);
 	}
 }
 
@@ -522,8 +1227,191 @@ uint64_t ska_get_time_ns(void) {
 #endif
 }
 
+// ========== Fast Clock ==========
+//
+// Opt-in via ska_init_info_t.fast_clock. Reading the CPU counter costs a few
+// ns against a few dozen for clock_gettime/QueryPerformanceCounter. The rate
+// comes from the OS clock over an ever longer baseline; once a second the
+// mapping is re-synced, slewing (not stepping) toward the OS clock so time
+// never jumps backwards.
+
+#define SKA_FAST_CLOCK_CALIBRATE_NS    50000000ULL // OS clock baseline before the first rate estimate
+#define SKA_FAST_CLOCK_RESYNC_NS     1000000000ULL
+#define SKA_FAST_CLOCK_STEP_NS          1000000ULL // Larger errors (suspend, counter jump) step instead
+#define SKA_FAST_CLOCK_MAX_SLEW         0.0005     // Rate adjustment cap while slewing (500 ppm)
+
+static inline uint64_t ska_fast_clock_ticks(void) {
+#if defined(SKA_FAST_CLOCK_X86)
+	return (uint64_t)__rdtsc();
+#elif defined(SKA_FAST_CLOCK_ARM64)
+	uint64_t ticks;
+	__asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+	return ticks;
+#else
+	return 0;
+#endif
+}
+
+// Whether the counter ticks at a constant rate, in step across cores and
+// through power states
+static bool ska_fast_clock_supported(void) {
+#if defined(SKA_FAST_CLOCK_X86)
+	uint32_t regs[4] = {0};
+#if defined(_MSC_VER)
+	int32_t info[4];
+	__cpuid(info, 0x80000000);
+	if ((uint32_t)info[0] < 0x80000007) return false;
+	__cpuid(info, 0x80000007);
+	regs[3] = (uint32_t)info[3];
+#else
+	if (!__get_cpuid(0x80000007, &regs[0], &regs[1], &regs[2], &regs[3])) return false;
+#endif
+	if (!(regs[3] & (1u << 8))) { // Invariant TSC
+		return false;
+	}
+
+#if defined(SKA_PLATFORM_LINUX) || defined(SKA_PLATFORM_ANDROID)
+	// The kernel drops the TSC as its clocksource when it catches it
+	// misbehaving (unsynced sockets, some VMs), so trust its verdict
+	FILE* file = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+	if (file) {
+		char source[32] = {0};
+		bool tsc = fgets(source, sizeof(source), file) && strncmp(source, "tsc", 3) == 0;
+		fclose(file);
+		if (!tsc) return false;
+	}
+#endif
+	return true;
+#elif defined(SKA_FAST_CLOCK_ARM64)
+	// The generic timer is architecturally constant-rate
+	return true;
+#else
+	return false;
+#endif
+}
+
+// OS clock read between two counter reads, returns the counter midpoint
+static uint64_t ska_fast_clock_sample(uint64_t* out_ns) {
+	uint64_t before = ska_fast_clock_ticks();
+	*out_ns         = ska_get_time_ns() - g_ska.start_time;
+	uint64_t after  = ska_fast_clock_ticks();
+	return before + (after - before) / 2;
+}
+
+static uint64_t ska_fast_clock_map(const ska_fast_clock_params_t* params, uint64_t ticks) {
+	// Signed, another core's counter may read a hair behind base_ticks
+	int64_t delta = (int64_t)(ticks - params->base_ticks);
+	return params->base_ns + (uint64_t)(int64_t)((double)delta * params->ns_per_tick);
+}
+
+static void ska_fast_clock_publish(const ska_fast_clock_params_t* params) {
+	ska_fast_clock_t* clock = &g_ska.fast_clock;
+	uint32_t slot = atomic_load_explicit(&clock->current, memory_order_relaxed) ^ 1;
+	clock->params[slot] = *params;
+	atomic_store_explicit(&clock->resync_ticks, (uint64_t)((double)SKA_FAST_CLOCK_RESYNC_NS / params->ns_per_tick), memory_order_relaxed);
+	atomic_store_explicit(&clock->current, slot, memory_order_release);
+	atomic_store_explicit(&clock->mode, ska_fast_clock_running, memory_order_release);
+}
+
+static void ska_fast_clock_init(void) {
+	ska_fast_clock_t* clock = &g_ska.fast_clock;
+	if (!ska_fast_clock_supported()) {
+		ska_log(ska_log_info, "Fast clock unavailable (no invariant CPU counter), using the OS clock");
+		return;
+	}
+
+	atomic_flag_clear(&clock->resyncing);
+	clock->anchor_ticks = ska_fast_clock_sample(&clock->anchor_ns);
+
+#if defined(SKA_FAST_CLOCK_ARM64)
+	// The rate is published by the CPU, no calibration needed
+	uint64_t frequency;
+	__asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+	if (frequency > 0) {
+		ska_fast_clock_params_t params = { clock->anchor_ticks, clock->anchor_ns, 1000000000.0 / (double)frequency };
+		ska_fast_clock_publish(&params);
+		return;
+	}
+#endif
+	atomic_store_explicit(&clock->mode, ska_fast_clock_calibrating, memory_order_release);
+}
+
+static void ska_fast_clock_resync(void) {
+	ska_fast_clock_t* clock = &g_ska.fast_clock;
+	if (atomic_flag_test_and_set_explicit(&clock->resyncing, memory_order_acquire)) {
+		return; // Another thread is on it, the current params are fine meanwhile
+	}
+
+	uint64_t now_ns;
+	uint64_t now_ticks = ska_fast_clock_sample(&now_ns);
+	uint32_t mode      = atomic_load_explicit(&clock->mode, memory_order_relaxed);
+
+	if (now_ticks <= clock->anchor_ticks || now_ns <= clock->anchor_ns) {
+		ska_log(ska_log_warn, "CPU counter went backwards, fast clock disabled");
+		atomic_store_explicit(&clock->mode, ska_fast_clock_off, memory_order_release);
+		atomic_flag_clear_explicit(&clock->resyncing, memory_order_release);
+		return;
+	}
+	if (mode == ska_fast_clock_calibrating && now_ns - clock->anchor_ns < SKA_FAST_CLOCK_CALIBRATE_NS) {
+		atomic_flag_clear_explicit(&clock->resyncing, memory_order_release);
+		return;
+	}
+
+	double rate = (double)(now_ns - clock->anchor_ns) / (double)(now_ticks - clock->anchor_ticks);
+	ska_fast_clock_params_t params = { now_ticks, now_ns, rate };
+
+	if (mode == ska_fast_clock_running) {
+		const ska_fast_clock_params_t* current = &clock->params[atomic_load_explicit(&clock->current, memory_order_relaxed)];
+		uint64_t estimate_ns = ska_fast_clock_map(current, now_ticks);
+		int64_t  error_ns    = (int64_t)(now_ns - estimate_ns);
+
+		if (error_ns > (int64_t)SKA_FAST_CLOCK_STEP_NS || error_ns < -(int64_t)SKA_FAST_CLOCK_STEP_NS) {
+			// The baseline no longer describes the counter, start a new one.
+			// Only step forward, a reader may already have seen estimate_ns.
+			params.base_ns      = estimate_ns > now_ns ? estimate_ns : now_ns;
+			params.ns_per_tick  = current->ns_per_tick;
+			clock->anchor_ticks = now_ticks;
+			clock->anchor_ns    = now_ns;
+		} else {
+			// Continue from where readers are and close the gap over the next interval
+			double slew = (double)error_ns / (double)SKA_FAST_CLOCK_RESYNC_NS;
+			if (slew >  SKA_FAST_CLOCK_MAX_SLEW) slew =  SKA_FAST_CLOCK_MAX_SLEW;
+			if (slew < -SKA_FAST_CLOCK_MAX_SLEW) slew = -SKA_FAST_CLOCK_MAX_SLEW;
+			params.base_ns     = estimate_ns;
+			params.ns_per_tick = rate * (1.0 + slew);
+		}
+	}
+
+	ska_fast_clock_publish(&params);
+	atomic_flag_clear_explicit(&clock->resyncing, memory_order_release);
+}
+
+SKA_API bool ska_time_is_fast_clock(void) {
+	return atomic_load_explicit(&g_ska.fast_clock.mode, memory_order_relaxed) == ska_fast_clock_running;
+}
+
 SKA_API uint64_t ska_time_get_elapsed_ns(void) {
-	return ska_get_time_ns() - g_ska.start_time;
+	ska_fast_clock_t* clock = &g_ska.fast_clock;
+	uint32_t          mode  = atomic_load_explicit(&clock->mode, memory_order_acquire);
+
+	if (mode == ska_fast_clock_running) {
+		uint64_t ticks = ska_fast_clock_ticks();
+		const ska_fast_clock_params_t* params = &clock->params[atomic_load_explicit(&clock->current, memory_order_acquire)];
+		// Signed like ska_fast_clock_map(), a read a hair behind base_ticks
+		// would otherwise wrap to a huge delta and resync on every call
+		int64_t delta = (int64_t)(ticks - params->base_ticks);
+		if (delta > 0 && (uint64_t)delta >= atomic_load_explicit(&clock->resync_ticks, memory_order_relaxed)) {
+			ska_fast_clock_resync();
+			params = &clock->params[atomic_load_explicit(&clock->current, memory_order_acquire)];
+		}
+		return ska_fast_clock_map(params, ticks);
+	}
+
+	uint64_t elapsed_ns = ska_get_time_ns() - g_ska.start_time;
+	if (mode == ska_fast_clock_calibrating && elapsed_ns - g_ska.fast_clock.anchor_ns >= SKA_FAST_CLOCK_CALIBRATE_NS) {
+		ska_fast_clock_resync();
+	}
+	return elapsed_ns;
 }
 
 SKA_API double ska_time_get_elapsed_s(void) {
@@ -538,12 +1426,126 @@ SKA_API void ska_time_sleep(uint32_t ms) {
 #endif
 }
 
+#ifdef SKA_PLATFORM_WIN32
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002 // Windows 10 1803+, older SDKs lack it
+#endif
+
+// Each thread that sleeps keeps one timer in fiber local storage instead of
+// creating a kernel object per sleep. The FLS callback closes it when the
+// thread exits or ska_shutdown() frees the index.
+static VOID WINAPI ska_win32_sleep_timer_free(PVOID timer) {
+	if (timer && timer != INVALID_HANDLE_VALUE) {
+		CloseHandle((HANDLE)timer);
+	}
+}
+
+// Returns NULL where high-resolution timers don't exist
+static HANDLE ska_win32_sleep_timer(void) {
+	if (g_sleep_timer_fls == FLS_OUT_OF_INDEXES) {
+		return NULL;
+	}
+	HANDLE timer = (HANDLE)FlsGetValue(g_sleep_timer_fls);
+	if (!timer) {
+		timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		// A failure is remembered too, so older systems don't retry on every sleep
+		FlsSetValue(g_sleep_timer_fls, timer ? timer : INVALID_HANDLE_VALUE);
+	}
+	return timer == INVALID_HANDLE_VALUE ? NULL : timer;
+}
+#endif
+
+SKA_API void ska_time_sleep_until_ns(uint64_t deadline_ns, uint64_t spin_ns) {
+	uint64_t now_ns   = ska_time_get_elapsed_ns();
+	uint64_t sleep_ns = deadline_ns > spin_ns ? deadline_ns - spin_ns : 0;
+
+	if (sleep_ns > now_ns) {
+#if defined(SKA_PLATFORM_WIN32)
+		// The high-resolution timer isn't tied to the timeBeginPeriod tick,
+		// fall back to Sleep's millisecond tick where it doesn't exist
+		HANDLE timer = ska_win32_sleep_timer();
+		if (timer) {
+			LARGE_INTEGER due;
+			due.QuadPart = -(LONGLONG)((sleep_ns - now_ns) / 100); // Relative, 100ns units
+			if (SetWaitableTimer(timer, &due, 0, NULL, NULL, FALSE)) {
+				WaitForSingleObject(timer, INFINITE);
+			}
+		} else {
+			Sleep((DWORD)((sleep_ns - now_ns) / 1000000ULL));
+		}
+#elif defined(SKA_PLATFORM_MACOS)
+		static mach_timebase_info_data_t timebase = {0};
+		if (timebase.denom == 0) {
+			mach_timebase_info(&timebase);
+		}
+		uint64_t clock_ns = g_ska.start_time + sleep_ns;
+		mach_wait_until(clock_ns * timebase.denom / timebase.numer);
+#else
+		// Same clock as ska_get_time_ns(), so the deadline needs no conversion
+		uint64_t        clock_ns = g_ska.start_time + sleep_ns;
+		struct timespec until;
+		until.tv_sec  = (time_t)(clock_ns / 1000000000ULL);
+		until.tv_nsec = (long)  (clock_ns % 1000000000ULL);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL) == EINTR) {}
+#endif
+	}
+
+	while (ska_time_get_elapsed_ns() < deadline_ns) {}
+}
+
+SKA_API void ska_frame_pacer_init(ska_frame_pacer_t* out_pacer, const ska_window_t* opt_window, float rate_hz) {
+	if (!out_pacer) return;
+
+	if (rate_hz <= 0.0f && opt_window) {
+		rate_hz = ska_window_get_refresh_rate(opt_window);
+	}
+	if (rate_hz <= 0.0f) {
+		rate_hz = 60.0f;
+	}
+
+	memset(out_pacer, 0, sizeof(*out_pacer));
+	out_pacer->period_ns        = (uint64_t)(1000000000.0 / (double)rate_hz);
+	out_pacer->next_deadline_ns = ska_time_get_elapsed_ns() + out_pacer->period_ns;
+}
+
+SKA_API void ska_frame_pacer_wait(ska_frame_pacer_t* ref_pacer) {
+	if (!ref_pacer || ref_pacer->period_ns == 0) return;
+
+	// Too far behind to catch up, start a fresh schedule from now
+	uint64_t now_ns = ska_time_get_elapsed_ns();
+	if (now_ns > ref_pacer->next_deadline_ns + ref_pacer->period_ns) {
+		ref_pacer->next_deadline_ns = now_ns;
+		ref_pacer->missed++;
+	}
+
+	ska_time_sleep_until_ns(ref_pacer->next_deadline_ns, ref_pacer->spin_ns);
+
+	uint64_t woke_ns = ska_time_get_elapsed_ns();
+	ref_pacer->jitter_ns        = woke_ns - ref_pacer->next_deadline_ns;
+	ref_pacer->jitter_total_ns += ref_pacer->jitter_ns;
+	ref_pacer->frames++;
+	ref_pacer->jitter_avg_ns    = ref_pacer->jitter_total_ns / ref_pacer->frames;
+	if (ref_pacer->jitter_ns > ref_pacer->jitter_max_ns) {
+		ref_pacer->jitter_max_ns = ref_pacer->jitter_ns;
+	}
+
+	ref_pacer->next_deadline_ns += ref_pacer->period_ns;
+}
+
 // ============================================================================
 // Clipboard Support
 // ============================================================================
 
 SKA_API char* ska_clipboard_get_text(void) {
-	return ska_platform_clipboard_get_text();
+	ska_profile_begin("ska_clipboard_get_text");
+	uint64_t start_ns = ska_time_get_elapsed_ns();
+	char*    text     = ska_platform_clipboard_get_text();
+	ska_stats_add(clipboard_wait_ns, ska_time_get_elapsed_ns() - start_ns);
+	if (text) {
+		ska_stats_add(allocations, 1); // Every backend returns a malloc'd copy
+	}
+	ska_profile_end();
+	return text;
 }
 
 SKA_API bool ska_clipboard_set_text(const char* text) {
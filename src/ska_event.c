@@ -1,40 +1,479 @@
 //
 // sk_app - Event queue implementation
+//
+// Single-producer/single-consumer and lock-free. The producer is whichever
+// thread translates platform events (the app thread on desktop, the looper
+// thread on Android), the consumer is the thread calling ska_event_poll().
+//
+// Events are written into a producer-private staging area and published in
+// batches by ska_event_queue_commit(), which lets ska_post_event() merge into
+// the newest staged event without racing the consumer.
+//
+// Growth chains a new segment of twice the size instead of reallocating, so
+// the consumer can keep reading the old one; it frees a segment once it is
+// drained and the producer has linked its successor.
+//
+// Slots hold the 32-byte ska_queued_event_t. Events are packed on push and
+// expanded on pop, so the public ska_event_t only exists at the API boundary.
 
 #include "ska_internal.h"
 
-void ska_event_queue_init(ska_event_queue_t* queue) {
+_Static_assert(sizeof(ska_queued_event_t) == 32, "ska_queued_event_t should stay half a cache line");
+
+static uint32_t ska_next_pow2(uint32_t value) {
+	uint32_t result = 1;
+	while (result < value && result < 0x80000000u) {
+		result <<= 1;
+	}
+	return result;
+}
+
+static ska_event_segment_t* ska_event_segment_create(uint32_t capacity) {
+	size_t size = sizeof(ska_event_segment_t) + capacity * sizeof(ska_queued_event_t);
+	ska_event_segment_t* segment = (ska_event_segment_t*)ska_aligned_alloc(SKA_CACHE_LINE, size);
+	if (!segment) {
+		return NULL;
+	}
+
+	memset(segment, 0, sizeof(*segment));
+	segment->capacity = capacity;
+	segment->mask     = capacity - 1;
+	atomic_init(&segment->next, NULL);
+	atomic_init(&segment->write_pos, 0);
+	atomic_init(&segment->read_pos, 0);
+	return segment;
+}
+
+bool ska_event_queue_init(ska_event_queue_t* queue, int32_t capacity, int32_t max_capacity) {
 	memset(queue, 0, sizeof(*queue));
+
+	if (capacity     <= 0) capacity     = SKA_EVENT_QUEUE_DEFAULT_CAPACITY;
+	if (max_capacity <= 0) max_capacity = SKA_EVENT_QUEUE_DEFAULT_MAX_CAPACITY;
+	if (max_capacity < capacity) max_capacity = capacity;
+
+	queue->max_capacity = ska_next_pow2((uint32_t)max_capacity);
+
+	ska_event_segment_t* segment = ska_event_segment_create(ska_next_pow2((uint32_t)capacity));
+	if (!segment) {
+		ska_set_error("Failed to allocate event queue (%d events)", capacity);
+		return false;
+	}
+
+	queue->write_segment = segment;
+	queue->read_segment  = segment;
+	atomic_init(&queue->capacity,   segment->capacity);
+	atomic_init(&queue->pushed,     0);
+	atomic_init(&queue->popped,     0);
+	atomic_init(&queue->high_water, 0);
+	atomic_init(&queue->dropped,    0);
+	atomic_init(&queue->coalesced,  0);
+	return true;
 }
 
-bool ska_event_queue_push(ska_event_queue_t* queue, const ska_event_t* event) {
-	if (queue->count >= SKA_EVENT_QUEUE_SIZE) {
+void ska_event_queue_free(ska_event_queue_t* queue) {
+	ska_event_segment_t* segment = queue->read_segment;
+	while (segment) {
+		// Text that never got popped still owns its out-of-line copy
+		uint32_t read_pos = atomic_load_explicit(&segment->read_pos, memory_order_relaxed);
+		for (uint32_t i = read_pos; i != segment->staged_pos; i++) {
+			ska_queued_event_t* event = &segment->events[i & segment->mask];
+			if (event->text_heap) free(event->text.heap);
+		}
+
+		ska_event_segment_t* next = atomic_load_explicit(&segment->next, memory_order_acquire);
+		ska_aligned_free(segment);
+		segment = next;
+	}
+	memset(queue, 0, sizeof(*queue));
+}
+
+// ============================================================================
+// Packing
+// ============================================================================
+
+static bool ska_event_pack(ska_queued_event_t* out, const ska_event_t* event, uint64_t timestamp_ns) {
+	memset(out, 0, sizeof(*out));
+	out->timestamp_ns = timestamp_ns;
+	out->type         = (uint8_t)event->type;
+
+	switch (event->type) {
+	case ska_event_key_down:
+	case ska_event_key_up:
+		out->window_id          = event->keyboard.window_id;
+		out->keyboard.scancode  = (uint16_t)event->keyboard.scancode;
+		out->keyboard.modifiers = event->keyboard.modifiers;
+		out->keyboard.pressed   = event->keyboard.pressed;
+		out->keyboard.repeat    = event->keyboard.repeat;
+		break;
+
+	case ska_event_text_input: {
+		out->window_id = event->text.window_id;
+		const char* end = (const char*)memchr(event->text.text, '\0', sizeof(event->text.text) - 1);
+		size_t length = end ? (size_t)(end - event->text.text) : sizeof(event->text.text) - 1;
+		if (length < SKA_QUEUED_TEXT_INLINE) {
+			memcpy(out->text.inline_utf8, event->text.text, length);
+		} else {
+			out->text.heap = (char*)malloc(length + 1);
+			if (!out->text.heap) {
+				return false;
+			}
+			ska_stats_add(allocations, 1);
+			memcpy(out->text.heap, event->text.text, length);
+			out->text.heap[length] = '\0';
+			out->text_heap = true;
+		}
+		break;
+	}
+
+	case ska_event_mouse_motion:
+		out->window_id          = event->mouse_motion.window_id;
+		out->mouse_motion.x     = event->mouse_motion.x;
+		out->mouse_motion.y     = event->mouse_motion.y;
+		out->mouse_motion.xrel  = event->mouse_motion.xrel;
+		out->mouse_motion.yrel  = event->mouse_motion.yrel;
+		break;
+
+	case ska_event_mouse_button_down:
+	case ska_event_mouse_button_up:
+		out->window_id            = event->mouse_button.window_id;
+		out->mouse_button.x       = event->mouse_button.x;
+		out->mouse_button.y       = event->mouse_button.y;
+		out->mouse_button.button  = (uint8_t)event->mouse_button.button;
+		out->mouse_button.clicks  = event->mouse_button.clicks;
+		out->mouse_button.pressed = event->mouse_button.pressed;
+		break;
+
+	case ska_event_mouse_wheel:
+		out->window_id              = event->mouse_wheel.window_id;
+		out->mouse_wheel.x          = event->mouse_wheel.x;
+		out->mouse_wheel.y          = event->mouse_wheel.y;
+		out->mouse_wheel.precise_x  = event->mouse_wheel.precise_x;
+		out->mouse_wheel.precise_y  = event->mouse_wheel.precise_y;
+		break;
+
+	case ska_event_file_dialog:
+		// id, title, cancelled and count are all read back from the result
+		out->file_dialog = (ska_file_dialog_result_t*)event->file_dialog._internal;
+		break;
+
+	case ska_event_user:
+		// No window to refer to, so code takes the window_id slot
+		out->window_id  = (ska_window_id_t)event->user.code;
+		out->user.data1 = event->user.data1;
+		out->user.data2 = event->user.data2;
+		break;
+
+	case ska_event_timer:
+		out->window_id         = event->timer.timer_id;
+		out->timer.user_data   = event->timer.user_data;
+		out->timer.expirations = event->timer.expirations;
+		break;
+
+	default:
+		// Window, app and quit events
+		out->window_id    = event->window.window_id;
+		out->window.data1 = event->window.data1;
+		out->window.data2 = event->window.data2;
+		break;
+	}
+	return true;
+}
+
+// Expands a queued event and releases anything it owned out-of-line
+static void ska_event_unpack(ska_event_t* out, ska_queued_event_t* event) {
+	memset(out, 0, sizeof(*out));
+	out->type         = (ska_event_)event->type;
+	out->timestamp_ns = event->timestamp_ns;
+	out->timestamp    = (uint32_t)(event->timestamp_ns / 1000000ULL);
+
+	switch (out->type) {
+	case ska_event_key_down:
+	case ska_event_key_up:
+		out->keyboard.window_id = event->window_id;
+		out->keyboard.scancode  = (ska_scancode_)event->keyboard.scancode;
+		out->keyboard.modifiers = event->keyboard.modifiers;
+		out->keyboard.pressed   = event->keyboard.pressed;
+		out->keyboard.repeat    = event->keyboard.repeat;
+		break;
+
+	case ska_event_text_input:
+		out->text.window_id = event->window_id;
+		if (event->text_heap) {
+			memcpy(out->text.text, event->text.heap, strlen(event->text.heap));
+			free(event->text.heap);
+			event->text_heap = false;
+		} else {
+			memcpy(out->text.text, event->text.inline_utf8, SKA_QUEUED_TEXT_INLINE);
+		}
+		break;
+
+	case ska_event_mouse_motion:
+		out->mouse_motion.window_id = event->window_id;
+		out->mouse_motion.x         = event->mouse_motion.x;
+		out->mouse_motion.y         = event->mouse_motion.y;
+		out->mouse_motion.xrel      = event->mouse_motion.xrel;
+		out->mouse_motion.yrel      = event->mouse_motion.yrel;
+		break;
+
+	case ska_event_mouse_button_down:
+	case ska_event_mouse_button_up:
+		out->mouse_button.window_id = event->window_id;
+		out->mouse_button.x         = event->mouse_button.x;
+		out->mouse_button.y         = event->mouse_button.y;
+		out->mouse_button.button    = (ska_mouse_button_)event->mouse_button.button;
+		out->mouse_button.clicks    = event->mouse_button.clicks;
+		out->mouse_button.pressed   = event->mouse_button.pressed;
+		break;
+
+	case ska_event_mouse_wheel:
+		out->mouse_wheel.window_id  = event->window_id;
+		out->mouse_wheel.x          = event->mouse_wheel.x;
+		out->mouse_wheel.y          = event->mouse_wheel.y;
+		out->mouse_wheel.precise_x  = event->mouse_wheel.precise_x;
+		out->mouse_wheel.precise_y  = event->mouse_wheel.precise_y;
+		break;
+
+	case ska_event_file_dialog: {
+		ska_file_dialog_result_t* result = event->file_dialog;
+		if (result) {
+			out->file_dialog.id        = result->id;
+			out->file_dialog.title     = result->title;
+			out->file_dialog.cancelled = result->cancelled;
+			out->file_dialog.count     = result->path_count;
+		}
+		out->file_dialog._internal = result;
+		break;
+	}
+
+	case ska_event_user:
+		out->user.code  = (int32_t)event->window_id;
+		out->user.data1 = event->user.data1;
+		out->user.data2 = event->user.data2;
+		break;
+
+	case ska_event_timer:
+		out->timer.timer_id    = event->window_id;
+		out->timer.expirations = event->timer.expirations;
+		out->timer.user_data   = event->timer.user_data;
+		break;
+
+	default:
+		out->window.window_id = event->window_id;
+		out->window.data1     = event->window.data1;
+		out->window.data2     = event->window.data2;
+		break;
+	}
+}
+
+// ============================================================================
+// Producer side
+// ============================================================================
+
+// Producer moves on to a segment twice the size of the current (full) one
+static bool ska_event_queue_grow(ska_event_queue_t* queue) {
+	ska_event_segment_t* current = queue->write_segment;
+	if (current->capacity >= queue->max_capacity) {
 		return false;
 	}
 
-	queue->events[queue->write_pos] = *event;
-	queue->write_pos = (queue->write_pos + 1) % SKA_EVENT_QUEUE_SIZE;
-	queue->count++;
+	ska_event_segment_t* segment = ska_event_segment_create(current->capacity * 2);
+	if (!segment) {
+		return false;
+	}
+	ska_stats_add(allocations, 1);
+
+	// Everything staged in the old segment must be visible before the consumer
+	// can see the link, or it could skip to the new segment early
+	ska_event_queue_commit(queue);
+	queue->write_segment = segment;
+	atomic_store_explicit(&current->next, segment, memory_order_release);
+	atomic_store_explicit(&queue->capacity, segment->capacity, memory_order_relaxed);
+	return true;
+}
+
+bool ska_event_queue_push(ska_event_queue_t* queue, const ska_event_t* event, uint64_t timestamp_ns, bool critical) {
+	// Droppable events stop short of the hard cap so there is always room left
+	// for the events an app cannot afford to lose (key up, close, focus...)
+	uint32_t reserved = queue->max_capacity / 4;
+	if (reserved > SKA_EVENT_QUEUE_RESERVED) reserved = SKA_EVENT_QUEUE_RESERVED;
+	uint32_t limit = critical ? queue->max_capacity : queue->max_capacity - reserved;
+
+	uint32_t count = ska_event_queue_count(queue);
+	if (count >= limit) {
+		atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+		return false;
+	}
+
+	ska_event_segment_t* segment = queue->write_segment;
+	uint32_t read_pos = atomic_load_explicit(&segment->read_pos, memory_order_acquire);
+	if (segment->staged_pos - read_pos >= segment->capacity) {
+		if (!ska_event_queue_grow(queue)) {
+			atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+			return false;
+		}
+		segment = queue->write_segment;
+	}
+
+	if (!ska_event_pack(&segment->events[segment->staged_pos & segment->mask], event, timestamp_ns)) {
+		atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+		return false;
+	}
+	segment->staged_pos++;
+	atomic_store_explicit(&queue->pushed, atomic_load_explicit(&queue->pushed, memory_order_relaxed) + 1, memory_order_relaxed);
+
+	count++;
+	if (count > atomic_load_explicit(&queue->high_water, memory_order_relaxed)) {
+		atomic_store_explicit(&queue->high_water, count, memory_order_relaxed);
+	}
 	return true;
 }
 
+ska_queued_event_t* ska_event_queue_peek_staged(ska_event_queue_t* queue) {
+	ska_event_segment_t* segment = queue->write_segment;
+	if (segment->staged_pos == atomic_load_explicit(&segment->write_pos, memory_order_relaxed)) {
+		return NULL;
+	}
+	return &segment->events[(segment->staged_pos - 1) & segment->mask];
+}
+
+void ska_event_queue_commit(ska_event_queue_t* queue) {
+	ska_event_segment_t* segment = queue->write_segment;
+	atomic_store_explicit(&segment->write_pos, segment->staged_pos, memory_order_release);
+}
+
+int32_t ska_event_queue_count(const ska_event_queue_t* queue) {
+	uint32_t pushed = atomic_load_explicit(&queue->pushed, memory_order_relaxed);
+	uint32_t popped = atomic_load_explicit(&queue->popped, memory_order_acquire);
+	return (int32_t)(pushed - popped);
+}
+
+// ============================================================================
+// Consumer side
+// ============================================================================
+
+// Returns the segment holding the next committed event, freeing drained
+// segments along the way, or NULL when there is nothing to read.
+static ska_event_segment_t* ska_event_queue_readable(ska_event_queue_t* queue, uint32_t* out_available) {
+	while (true) {
+		ska_event_segment_t* segment = queue->read_segment;
+		uint32_t read_pos  = atomic_load_explicit(&segment->read_pos,  memory_order_relaxed);
+		uint32_t write_pos = atomic_load_explicit(&segment->write_pos, memory_order_acquire);
+		if (write_pos != read_pos) {
+			*out_available = write_pos - read_pos;
+			return segment;
+		}
+
+		ska_event_segment_t* next = atomic_load_explicit(&segment->next, memory_order_acquire);
+		if (!next) {
+			return NULL;
+		}
+
+		// The producer commits before linking, so re-check once the link is seen
+		write_pos = atomic_load_explicit(&segment->write_pos, memory_order_acquire);
+		if (write_pos != read_pos) {
+			*out_available = write_pos - read_pos;
+			return segment;
+		}
+
+		queue->read_segment = next;
+		ska_aligned_free(segment);
+	}
+}
+
+static void ska_event_queue_advance(ska_event_queue_t* queue, ska_event_segment_t* segment, uint32_t count) {
+	uint32_t read_pos = atomic_load_explicit(&segment->read_pos, memory_order_relaxed);
+	atomic_store_explicit(&segment->read_pos, read_pos + count, memory_order_release);
+	uint32_t popped = atomic_load_explicit(&queue->popped, memory_order_relaxed);
+	atomic_store_explicit(&queue->popped, popped + count, memory_order_release);
+}
+
 bool ska_event_queue_pop(ska_event_queue_t* queue, ska_event_t* event) {
-	if (queue->count == 0) {
+	uint32_t available;
+	ska_event_segment_t* segment = ska_event_queue_readable(queue, &available);
+	if (!segment) {
 		return false;
 	}
 
-	*event = queue->events[queue->read_pos];
-	queue->read_pos = (queue->read_pos + 1) % SKA_EVENT_QUEUE_SIZE;
-	queue->count--;
+	uint32_t read_pos = atomic_load_explicit(&segment->read_pos, memory_order_relaxed);
+	ska_event_unpack(event, &segment->events[read_pos & segment->mask]);
+	ska_event_queue_advance(queue, segment, 1);
 	return true;
 }
 
-bool ska_event_queue_is_empty(const ska_event_queue_t* queue) {
-	return queue->count == 0;
+int32_t ska_event_queue_pop_batch(ska_event_queue_t* queue, ska_event_t* out_events, int32_t max_events) {
+	int32_t total = 0;
+	while (total < max_events) {
+		uint32_t available;
+		ska_event_segment_t* segment = ska_event_queue_readable(queue, &available);
+		if (!segment) {
+			break;
+		}
+
+		uint32_t count = (uint32_t)(max_events - total);
+		if (count > available) count = available;
+
+		uint32_t read_pos = atomic_load_explicit(&segment->read_pos, memory_order_relaxed);
+		for (uint32_t i = 0; i < count; i++) {
+			ska_event_unpack(&out_events[total + (int32_t)i], &segment->events[(read_pos + i) & segment->mask]);
+		}
+
+		ska_event_queue_advance(queue, segment, count);
+		total += (int32_t)count;
+	}
+	return total;
+}
+
+bool ska_event_queue_is_empty(ska_event_queue_t* queue) {
+	uint32_t available;
+	return ska_event_queue_readable(queue, &available) == NULL;
+}
+
+// ============================================================================
+// Inbox
+// ============================================================================
+//
+// Bounded multi-producer/single-consumer ring (after Vyukov). Each slot's
+// sequence says whose turn it is: pos when free for the producer claiming
+// pos, pos + 1 once written, pos + SKA_EVENT_INBOX_SIZE once consumed.
+
+void ska_event_inbox_init(ska_event_inbox_t* inbox) {
+	atomic_store_explicit(&inbox->write_pos, 0, memory_order_relaxed);
+	inbox->read_pos = 0;
+	for (uint32_t i = 0; i < SKA_EVENT_INBOX_SIZE; i++) {
+		atomic_store_explicit(&inbox->slots[i].sequence, i, memory_order_relaxed);
+	}
 }
 
-void ska_event_queue_clear(ska_event_queue_t* queue) {
-	queue->read_pos = 0;
-	queue->write_pos = 0;
-	queue->count = 0;
+bool ska_event_inbox_push(ska_event_inbox_t* inbox, const ska_event_t* event) {
+	ska_event_inbox_slot_t* slot;
+	uint32_t pos = atomic_load_explicit(&inbox->write_pos, memory_order_relaxed);
+	while (true) {
+		slot = &inbox->slots[pos & (SKA_EVENT_INBOX_SIZE - 1)];
+		int32_t diff = (int32_t)(atomic_load_explicit(&slot->sequence, memory_order_acquire) - pos);
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&inbox->write_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			return false; // Consumer hasn't freed this slot yet, the ring is full
+		} else {
+			pos = atomic_load_explicit(&inbox->write_pos, memory_order_relaxed);
+		}
+	}
+
+	slot->event = *event;
+	atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+	return true;
+}
+
+bool ska_event_inbox_pop(ska_event_inbox_t* inbox, ska_event_t* out_event) {
+	ska_event_inbox_slot_t* slot = &inbox->slots[inbox->read_pos & (SKA_EVENT_INBOX_SIZE - 1)];
+	if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != inbox->read_pos + 1) {
+		return false;
+	}
+
+	*out_event = slot->event;
+	atomic_store_explicit(&slot->sequence, inbox->read_pos + SKA_EVENT_INBOX_SIZE, memory_order_release);
+	inbox->read_pos++;
+	return true;
 }
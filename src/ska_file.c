@@ -31,7 +31,7 @@
 // File I/O Implementation
 // ============================================================================
 
-SKA_API bool ska_file_read(const char* filename, void** out_data, size_t* out_size) {
+static bool ska_file_read_impl(const char* filename, void** out_data, size_t* out_size) {
 	if (!filename) {
 		ska_set_error("ska_file_read: NULL filename");
 		return false;
@@ -67,9 +67,12 @@ SKA_API bool ska_file_read(const char* filename, void** out_data, size_t* out_si
 		return false;
 	}
 
+	ska_stats_add(allocations, 1);
+
 	// Read file
 	size_t bytes_read = fread(data, 1, (size_t)file_size, file);
 	fclose(file);
+	ska_stats_add(file_bytes_read, bytes_read);
 
 	if (bytes_read != (size_t)file_size) {
 		ska_set_error("ska_file_read: Read %zu bytes, expected %ld", bytes_read, file_size);
@@ -85,6 +88,13 @@ SKA_API bool ska_file_read(const char* filename, void** out_data, size_t* out_si
 	return true;
 }
 
+SKA_API bool ska_file_read(const char* filename, void** out_data, size_t* out_size) {
+	ska_profile_begin("ska_file_read");
+	bool result = ska_file_read_impl(filename, out_data, out_size);
+	ska_profile_end();
+	return result;
+}
+
 SKA_API bool ska_file_read_text(const char* filename, char** out_text) {
 	if (!filename) {
 		ska_set_error("ska_file_read_text: NULL filename");
@@ -325,7 +335,7 @@ SKA_API bool ska_set_cwd(const char* opt_path) {
 
 #ifndef SKA_PLATFORM_ANDROID
 
-SKA_API bool ska_asset_read(const char* asset_name, void** out_data, size_t* out_size) {
+static bool ska_asset_read_impl(const char* asset_name, void** out_data, size_t* out_size) {
 	if (!asset_name) {
 		ska_set_error("ska_asset_read: NULL asset_name");
 		return false;
@@ -365,6 +375,13 @@ SKA_API bool ska_asset_read(const char* asset_name, void** out_data, size_t* out
 	return false;
 }
 
+SKA_API bool ska_asset_read(const char* asset_name, void** out_data, size_t* out_size) {
+	ska_profile_begin("ska_asset_read");
+	bool result = ska_asset_read_impl(asset_name, out_data, out_size);
+	ska_profile_end();
+	return result;
+}
+
 SKA_API bool ska_asset_read_text(const char* asset_name, char** out_text) {
 	if (!asset_name) {
 		ska_set_error("ska_asset_read_text: NULL asset_name");
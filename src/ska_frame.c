@@ -0,0 +1,204 @@
+//
+// sk_app - Frame statistics
+//
+// Frame times are counted in a log-linear histogram: 16 linear buckets per
+// power of two of microseconds (1024 ns units), so each bucket is at most
+// 1/16th of its value wide and percentiles need no stored samples. Event
+// counts and pump time come from g_ska.frame_events and g_ska.frame_pump_ns,
+// which the poll functions and ska_event_pump() fill while a frame is open.
+// Round trips are the change in the global counter, so ones made by the
+// input thread during the frame are included.
+
+#include "ska_internal.h"
+
+#define SKA_FRAME_SUB_BITS      4
+#define SKA_FRAME_SUB_COUNT     (1 << SKA_FRAME_SUB_BITS)
+#define SKA_FRAME_OCTAVES       24  // Top bucket starts near 2^28 us, longer frames clamp into it
+#define SKA_FRAME_BUCKETS       (SKA_FRAME_SUB_COUNT * (SKA_FRAME_OCTAVES + 1))
+#define SKA_FRAME_UNIT_SHIFT    10
+#define SKA_FRAME_REFRESH_NS    1000000000ULL // Re-query the refresh rate this often
+
+typedef struct ska_frame_state_t {
+	uint32_t histogram[SKA_FRAME_BUCKETS];
+	uint64_t frames;
+	uint64_t total_ns;
+	uint64_t max_ns;
+	uint64_t last_ns;
+	uint64_t missed_vsync;
+	uint64_t events;
+	uint32_t events_max;
+	uint64_t pump_ns;
+	uint64_t pump_max_ns;
+	uint64_t round_trips;
+	uint32_t round_trips_max;
+
+	uint64_t begin_ns;          // Start of the open frame
+	uint64_t begin_round_trips; // ska_stats_t.display_round_trips at the start of the open frame
+	uint64_t prev_begin_ns;     // Start of the frame before it, 0 if none
+
+	ska_window_id_t refresh_window;
+	uint64_t        refresh_checked_ns;
+	float           refresh_rate_hz;
+} ska_frame_state_t;
+
+static ska_frame_state_t g_ska_frame = {0};
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+static uint32_t ska_frame_bucket(uint64_t ns) {
+	uint64_t units = ns >> SKA_FRAME_UNIT_SHIFT;
+	if (units < SKA_FRAME_SUB_COUNT) {
+		return (uint32_t)units;
+	}
+
+	uint32_t msb = SKA_FRAME_SUB_BITS;
+	while ((units >> (msb + 1)) != 0) {
+		msb++;
+	}
+	uint32_t bucket = (msb - SKA_FRAME_SUB_BITS + 1) * SKA_FRAME_SUB_COUNT
+		+ (uint32_t)((units >> (msb - SKA_FRAME_SUB_BITS)) & (SKA_FRAME_SUB_COUNT - 1));
+	return bucket < SKA_FRAME_BUCKETS ? bucket : SKA_FRAME_BUCKETS - 1;
+}
+
+// Smallest value that lands in bucket
+static uint64_t ska_frame_bucket_floor(uint32_t bucket) {
+	if (bucket < SKA_FRAME_SUB_COUNT) {
+		return (uint64_t)bucket << SKA_FRAME_UNIT_SHIFT;
+	}
+	uint32_t msb = bucket / SKA_FRAME_SUB_COUNT + SKA_FRAME_SUB_BITS - 1;
+	uint64_t sub = bucket % SKA_FRAME_SUB_COUNT;
+	return ((SKA_FRAME_SUB_COUNT + sub) << (msb - SKA_FRAME_SUB_BITS)) << SKA_FRAME_UNIT_SHIFT;
+}
+
+static uint64_t ska_frame_percentile(double fraction) {
+	if (g_ska_frame.frames == 0) {
+		return 0;
+	}
+
+	uint64_t rank  = (uint64_t)(fraction * (double)g_ska_frame.frames + 0.5);
+	uint64_t count = 0;
+	if (rank == 0) rank = 1;
+	for (uint32_t i = 0; i < SKA_FRAME_BUCKETS; i++) {
+		count += g_ska_frame.histogram[i];
+		if (count >= rank) {
+			// Bucket midpoint, the true value is somewhere inside it
+			uint64_t low  = ska_frame_bucket_floor(i);
+			uint64_t high = i + 1 < SKA_FRAME_BUCKETS ? ska_frame_bucket_floor(i + 1) : low * 2;
+			uint64_t mid  = low + (high - low) / 2;
+			return mid < g_ska_frame.max_ns ? mid : g_ska_frame.max_ns;
+		}
+	}
+	return g_ska_frame.max_ns;
+}
+
+// ============================================================================
+// Internal
+// ============================================================================
+
+void ska_frame_clear(void) {
+	memset(&g_ska_frame, 0, sizeof(g_ska_frame));
+	g_ska.frame_open    = false;
+	g_ska.frame_events  = 0;
+	g_ska.frame_pump_ns = 0;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+SKA_API void ska_frame_begin(const ska_window_t* opt_window) {
+	uint64_t now_ns = ska_time_get_elapsed_ns();
+	g_ska_frame.begin_round_trips = atomic_load_explicit(&g_ska.stats.display_round_trips, memory_order_relaxed);
+
+	// Refresh rate queries aren't free everywhere (EnumDisplaySettings, display
+	// mode copies on macOS), so they're cached per window and only repeated
+	// once a second to follow the window onto other monitors
+	ska_window_id_t window_id = opt_window ? opt_window->id : 0;
+	if (g_ska_frame.refresh_rate_hz <= 0.0f || window_id != g_ska_frame.refresh_window || now_ns - g_ska_frame.refresh_checked_ns >= SKA_FRAME_REFRESH_NS) {
+		float rate_hz = opt_window ? ska_window_get_refresh_rate(opt_window) : 0.0f;
+		g_ska_frame.refresh_rate_hz    = rate_hz > 0.0f ? rate_hz : 60.0f;
+		g_ska_frame.refresh_window     = window_id;
+		g_ska_frame.refresh_checked_ns = now_ns;
+	}
+
+	// Every refresh period past the first that this frame's predecessor
+	// spanned is one the display showed a stale image for
+	if (g_ska_frame.prev_begin_ns != 0) {
+		uint64_t period_ns   = (uint64_t)(1000000000.0 / (double)g_ska_frame.refresh_rate_hz);
+		uint64_t interval_ns = now_ns - g_ska_frame.prev_begin_ns;
+		if (interval_ns * 2 > period_ns * 3) {
+			g_ska_frame.missed_vsync += (interval_ns + period_ns / 2) / period_ns - 1;
+		}
+	}
+	g_ska_frame.prev_begin_ns = now_ns;
+	g_ska_frame.begin_ns      = now_ns;
+
+	g_ska.frame_open    = true;
+	g_ska.frame_events  = 0;
+	g_ska.frame_pump_ns = 0;
+}
+
+SKA_API void ska_frame_end(void) {
+	if (!g_ska.frame_open) {
+		return;
+	}
+	g_ska.frame_open = false;
+
+	uint64_t frame_ns = ska_time_get_elapsed_ns() - g_ska_frame.begin_ns;
+	g_ska_frame.histogram[ska_frame_bucket(frame_ns)]++;
+	g_ska_frame.frames++;
+	g_ska_frame.total_ns += frame_ns;
+	g_ska_frame.last_ns   = frame_ns;
+	if (frame_ns > g_ska_frame.max_ns) g_ska_frame.max_ns = frame_ns;
+
+	g_ska_frame.events  += g_ska.frame_events;
+	g_ska_frame.pump_ns += g_ska.frame_pump_ns;
+	if (g_ska.frame_events  > g_ska_frame.events_max)  g_ska_frame.events_max  = g_ska.frame_events;
+	if (g_ska.frame_pump_ns > g_ska_frame.pump_max_ns) g_ska_frame.pump_max_ns = g_ska.frame_pump_ns;
+
+	uint64_t round_trips = atomic_load_explicit(&g_ska.stats.display_round_trips, memory_order_relaxed) - g_ska_frame.begin_round_trips;
+	if (round_trips > UINT32_MAX) round_trips = UINT32_MAX;
+	g_ska_frame.round_trips += round_trips;
+	if (round_trips > g_ska_frame.round_trips_max) g_ska_frame.round_trips_max = (uint32_t)round_trips;
+}
+
+SKA_API void ska_frame_stats_get(ska_frame_stats_t* out_stats) {
+	if (!out_stats) return;
+
+	memset(out_stats, 0, sizeof(*out_stats));
+	out_stats->frames                  = g_ska_frame.frames;
+	out_stats->frame_p50_ns            = ska_frame_percentile(0.50);
+	out_stats->frame_p95_ns            = ska_frame_percentile(0.95);
+	out_stats->frame_p99_ns            = ska_frame_percentile(0.99);
+	out_stats->frame_max_ns            = g_ska_frame.max_ns;
+	out_stats->frame_avg_ns            = g_ska_frame.frames > 0 ? g_ska_frame.total_ns / g_ska_frame.frames : 0;
+	out_stats->frame_last_ns           = g_ska_frame.last_ns;
+	out_stats->refresh_rate_hz         = g_ska_frame.refresh_rate_hz;
+	out_stats->missed_vsync            = g_ska_frame.missed_vsync;
+	out_stats->events                  = g_ska_frame.events;
+	out_stats->events_max              = g_ska_frame.events_max;
+	out_stats->pump_ns                 = g_ska_frame.pump_ns;
+	out_stats->pump_max_ns             = g_ska_frame.pump_max_ns;
+	out_stats->display_round_trips     = g_ska_frame.round_trips;
+	out_stats->display_round_trips_max = g_ska_frame.round_trips_max;
+}
+
+SKA_API void ska_frame_stats_reset(void) {
+	// Keep the open frame and the begin-to-begin chain running
+	uint64_t        begin_ns      = g_ska_frame.begin_ns;
+	uint64_t        begin_trips   = g_ska_frame.begin_round_trips;
+	uint64_t        prev_begin_ns = g_ska_frame.prev_begin_ns;
+	ska_window_id_t window        = g_ska_frame.refresh_window;
+	uint64_t        checked_ns    = g_ska_frame.refresh_checked_ns;
+	float           rate_hz       = g_ska_frame.refresh_rate_hz;
+
+	memset(&g_ska_frame, 0, sizeof(g_ska_frame));
+	g_ska_frame.begin_ns           = begin_ns;
+	g_ska_frame.begin_round_trips  = begin_trips;
+	g_ska_frame.prev_begin_ns      = prev_begin_ns;
+	g_ska_frame.refresh_window     = window;
+	g_ska_frame.refresh_checked_ns = checked_ns;
+	g_ska_frame.refresh_rate_hz    = rate_hz;
+}
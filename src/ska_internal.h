@@ -11,6 +11,7 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <time.h>
+#include <stdatomic.h>
 
 // POSIX includes for Linux/macOS
 #if defined(SKA_PLATFORM_LINUX) || defined(SKA_PLATFORM_MACOS)
@@ -33,6 +34,7 @@
 	#include <X11/extensions/XInput2.h>
 	#include <X11/cursorfont.h>
 	#include <X11/Xcursor/Xcursor.h>
+	#include <pthread.h>
 #endif
 
 #ifdef SKA_PLATFORM_MACOS
@@ -100,20 +102,119 @@ typedef enum VkStructureType {
 // Event Queue
 // ============================================================================
 
-#define SKA_EVENT_QUEUE_SIZE 256
-
+#define SKA_EVENT_QUEUE_DEFAULT_CAPACITY     256
+#define SKA_EVENT_QUEUE_DEFAULT_MAX_CAPACITY 65536
+#define SKA_EVENT_QUEUE_RESERVED             32 // Slots at the hard cap only critical events may use
+#define SKA_EVENT_COALESCE_DEFAULT_THRESHOLD 64 // Queue depth where motion/wheel start merging
+
+// Size used to keep producer-written and consumer-written fields of the
+// lock-free queues on separate cache lines
+#define SKA_CACHE_LINE 64
+
+// Compact form of ska_event_t stored in the queue, 32 bytes instead of 56 so
+// a motion flood copies fewer bytes and two events share a cache line. Short
+// text stays inline, longer text and file dialog results are referenced
+// out-of-line; ska_event_queue_pop() expands back to ska_event_t.
+#define SKA_QUEUED_TEXT_INLINE 16
+
+typedef struct ska_queued_event_t {
+	uint64_t        timestamp_ns;
+	ska_window_id_t window_id;
+	uint8_t         type;      // ska_event_
+	bool            text_heap; // text.heap owns a malloc'd copy
+	uint16_t        reserved;
+	union {
+		struct { int32_t data1, data2; }                                     window;
+		struct { uint16_t scancode, modifiers; bool pressed, repeat; }       keyboard;
+		union  { char inline_utf8[SKA_QUEUED_TEXT_INLINE]; char* heap; }     text;
+		struct { int32_t x, y, xrel, yrel; }                                 mouse_motion;
+		struct { int32_t x, y; uint8_t button, clicks; bool pressed; }       mouse_button;
+		struct { int32_t x, y; float precise_x, precise_y; }                 mouse_wheel;
+		struct ska_file_dialog_result_t*                                     file_dialog;
+		struct { void* data1; void* data2; }                                 user;  // code is in window_id
+		struct { void* user_data; uint32_t expirations; }                    timer; // timer_id is in window_id
+	};
+} ska_queued_event_t;
+
+// One power-of-two ring in the chain that makes up the event queue. Positions
+// run freely and are masked on access. Events in [write_pos, staged_pos) are
+// written but not yet visible to the consumer.
+typedef struct ska_event_segment_t {
+	// Producer side
+	_Alignas(SKA_CACHE_LINE) _Atomic uint32_t   write_pos;
+	uint32_t                                    staged_pos;
+	uint32_t                                    capacity;
+	uint32_t                                    mask;
+	struct ska_event_segment_t* _Atomic         next; // Set once the producer moves on
+
+	// Consumer side
+	_Alignas(SKA_CACHE_LINE) _Atomic uint32_t   read_pos;
+
+	_Alignas(SKA_CACHE_LINE) ska_queued_event_t events[];
+} ska_event_segment_t;
+
+// Lock-free single-producer/single-consumer event queue, see ska_event.c
 typedef struct ska_event_queue_t {
-	ska_event_t events[SKA_EVENT_QUEUE_SIZE];
-	int32_t read_pos;
-	int32_t write_pos;
-	int32_t count;
+	// Producer side
+	_Alignas(SKA_CACHE_LINE) ska_event_segment_t* write_segment;
+	uint32_t                                     max_capacity;
+	_Atomic uint32_t                             capacity;   // Size of the newest segment
+	_Atomic uint32_t                             pushed;     // Total events staged
+	_Atomic uint32_t                             high_water;
+	_Atomic uint64_t                             dropped;
+	_Atomic uint64_t                             coalesced;
+
+	// Consumer side
+	_Alignas(SKA_CACHE_LINE) ska_event_segment_t* read_segment;
+	_Atomic uint32_t                             popped;     // Total events consumed
 } ska_event_queue_t;
 
-void ska_event_queue_init(ska_event_queue_t* queue);
-bool ska_event_queue_push(ska_event_queue_t* queue, const ska_event_t* event);
-bool ska_event_queue_pop(ska_event_queue_t* queue, ska_event_t* event);
-bool ska_event_queue_is_empty(const ska_event_queue_t* queue);
-void ska_event_queue_clear(ska_event_queue_t* queue);
+bool ska_event_queue_init(ska_event_queue_t* queue, int32_t capacity, int32_t max_capacity);
+void ska_event_queue_free(ska_event_queue_t* queue);
+
+// Producer thread only
+bool                ska_event_queue_push(ska_event_queue_t* queue, const ska_event_t* event, uint64_t timestamp_ns, bool critical);
+ska_queued_event_t* ska_event_queue_peek_staged(ska_event_queue_t* queue); // Newest unpublished event, or NULL
+void                ska_event_queue_commit(ska_event_queue_t* queue);      // Publish staged events to the consumer
+
+// Consumer thread only
+bool    ska_event_queue_pop(ska_event_queue_t* queue, ska_event_t* event);
+int32_t ska_event_queue_pop_batch(ska_event_queue_t* queue, ska_event_t* out_events, int32_t max_events);
+bool    ska_event_queue_is_empty(ska_event_queue_t* queue);
+
+// Any thread, staged events included
+int32_t ska_event_queue_count(const ska_event_queue_t* queue);
+
+// Events pushed from other threads wait here until the event producer thread
+// moves them into the queue, see ska_post_inbox_events()
+#define SKA_EVENT_INBOX_SIZE 1024 // Must be a power of two
+
+typedef struct ska_event_inbox_slot_t {
+	_Atomic uint32_t sequence;
+	ska_event_t      event;
+} ska_event_inbox_slot_t;
+
+// Lock-free multi-producer/single-consumer ring, see ska_event.c
+typedef struct ska_event_inbox_t {
+	_Alignas(SKA_CACHE_LINE) _Atomic uint32_t       write_pos; // Any thread
+	_Alignas(SKA_CACHE_LINE) uint32_t               read_pos;  // Event producer thread
+	_Alignas(SKA_CACHE_LINE) ska_event_inbox_slot_t slots[SKA_EVENT_INBOX_SIZE];
+} ska_event_inbox_t;
+
+void ska_event_inbox_init(ska_event_inbox_t* inbox);
+bool ska_event_inbox_push(ska_event_inbox_t* inbox, const ska_event_t* event); // Any thread, false when full
+bool ska_event_inbox_pop (ska_event_inbox_t* inbox, ska_event_t* out_event);  // Event producer thread only
+
+// ============================================================================
+// Event Hooks
+// ============================================================================
+
+#define SKA_MAX_EVENT_WATCHES 8
+
+typedef struct ska_event_watch_t {
+	ska_event_watch_fn fn;
+	void*              user_data;
+} ska_event_watch_t;
 
 // ============================================================================
 // Input State
@@ -123,13 +224,13 @@ void ska_event_queue_clear(ska_event_queue_t* queue);
 // Text Input Queue
 // ============================================================================
 
-#define SKA_TEXT_QUEUE_SIZE 256
+#define SKA_TEXT_QUEUE_SIZE 256 // Must be a power of two
 
+// Lock-free single-producer/single-consumer ring of UTF-32 codepoints
 typedef struct ska_text_queue_t {
-	uint32_t codepoints[SKA_TEXT_QUEUE_SIZE];  // UTF-32 codepoints
-	int32_t read_pos;
-	int32_t write_pos;
-	int32_t count;
+	_Alignas(SKA_CACHE_LINE) _Atomic uint32_t write_pos; // Producer side
+	_Alignas(SKA_CACHE_LINE) _Atomic uint32_t read_pos;  // Consumer side
+	_Alignas(SKA_CACHE_LINE) uint32_t         codepoints[SKA_TEXT_QUEUE_SIZE];
 } ska_text_queue_t;
 
 // Internal text queue functions
@@ -166,12 +267,28 @@ void ska_input_state_reset(ska_input_state_t* state);
 // Window Structure
 // ============================================================================
 
-#define SKA_MAX_WINDOWS 16
+// Window ids are (generation << SKA_WINDOW_SLOT_BITS) | (slot + 1), so a
+// destroyed window's id stops resolving even once its slot is reused
+#define SKA_WINDOW_SLOT_BITS 16
+#define SKA_WINDOW_SLOT_MASK ((1u << SKA_WINDOW_SLOT_BITS) - 1)
+
+typedef struct ska_window_slot_t {
+	ska_window_t* window;     // NULL while free
+	uint32_t      generation; // Bumped each time the slot is freed
+	uint32_t      next_free;  // 1 + next free slot, 0 ends the list
+} ska_window_slot_t;
+
+typedef struct ska_window_native_t {
+	uintptr_t     handle; // 0 marks an empty bucket
+	ska_window_t* window;
+} ska_window_native_t;
 
 struct ska_window_t {
 	ska_window_id_t id;
 	uint32_t flags;
 	char* title;
+	uint32_t  list_index;    // Position in g_ska.windows
+	uintptr_t native_handle; // Key in g_ska.window_natives, 0 if not registered
 
 	int32_t x, y;
 	int32_t width, height;
@@ -194,6 +311,12 @@ struct ska_window_t {
 	Window xwindow;
 	XIC xic;
 	bool mouse_warped;
+	int32_t frame_extents[4]; // _NET_FRAME_EXTENTS left, right, top, bottom, kept current by PropertyNotify
+	Window parent; // Root, or the frame a reparenting window manager put us in
+	bool resize_pending; // ConfigureNotify changes, posted by ska_linux_post_pending() or ahead of input for the window
+	bool move_pending;
+	bool position_dirty; // Framed by a window manager, x/y are stale until asked for
+	uint64_t configure_time_ns;
 #endif
 
 #ifdef SKA_PLATFORM_MACOS
@@ -208,6 +331,88 @@ struct ska_window_t {
 	void* user_data;
 };
 
+// ============================================================================
+// Fast Clock
+// ============================================================================
+
+typedef enum ska_fast_clock_ {
+	ska_fast_clock_off = 0,
+	ska_fast_clock_calibrating, // Counter rate unknown yet, reads use the OS clock
+	ska_fast_clock_running,
+} ska_fast_clock_;
+
+// Counter ticks to elapsed ns: base_ns + (ticks - base_ticks) * ns_per_tick
+typedef struct ska_fast_clock_params_t {
+	uint64_t base_ticks;
+	uint64_t base_ns;
+	double   ns_per_tick;
+} ska_fast_clock_params_t;
+
+// See ska_fast_clock_resync. Readers take params[current]; a re-sync writes
+// the other slot and flips current, so the slot a reader holds stays intact
+// for a full re-sync interval.
+typedef struct ska_fast_clock_t {
+	_Atomic uint32_t        mode;         // ska_fast_clock_
+	_Atomic uint32_t        current;
+	ska_fast_clock_params_t params[2];
+	_Atomic uint64_t        resync_ticks; // Ticks between re-syncs
+	atomic_flag             resyncing;    // Only one thread re-syncs at a time
+	uint64_t                anchor_ticks; // Long baseline for the counter rate, guarded by resyncing
+	uint64_t                anchor_ns;
+} ska_fast_clock_t;
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+// Backing store for ska_stats_get(). Everything is relaxed: counters only
+// need to be eventually visible to a scraping thread, not ordered.
+typedef struct ska_stats_counters_t {
+	_Atomic uint64_t events_posted[SKA_STATS_EVENT_TYPES];
+	_Atomic uint64_t events_dropped[SKA_STATS_EVENT_TYPES];
+	_Atomic uint64_t events_coalesced[SKA_STATS_EVENT_TYPES];
+	_Atomic uint64_t text_codepoints_dropped;
+	_Atomic uint64_t pump_calls;
+	_Atomic uint64_t pump_ns;
+	_Atomic uint64_t display_flushes;
+	_Atomic uint64_t display_requests;
+	_Atomic uint64_t display_round_trips;
+	_Atomic uint64_t clipboard_wait_ns;
+	_Atomic uint64_t file_bytes_read;
+	_Atomic uint64_t allocations;
+} ska_stats_counters_t;
+
+#ifdef SKA_PLATFORM_LINUX
+// ============================================================================
+// X11 Atoms
+// ============================================================================
+
+// Every atom the X11 backend uses, interned together by ska_platform_init in
+// one XInternAtoms round trip. Index g_ska.x_atoms with these.
+typedef enum ska_x_atom_ {
+	ska_x_atom_wm_protocols = 0,
+	ska_x_atom_wm_delete_window,
+	ska_x_atom_net_wm_state,
+	ska_x_atom_net_wm_state_fullscreen,
+	ska_x_atom_net_wm_state_maximized_vert,
+	ska_x_atom_net_wm_state_maximized_horz,
+	ska_x_atom_net_wm_pid,
+	ska_x_atom_net_wm_icon,
+	ska_x_atom_net_frame_extents,
+	ska_x_atom_net_workarea,
+	ska_x_atom_motif_wm_hints,
+	ska_x_atom_resource_manager, // For DPI change detection
+	ska_x_atom_clipboard,
+	ska_x_atom_targets,
+	ska_x_atom_text,
+	ska_x_atom_utf8_string,
+	ska_x_atom_text_plain,
+	ska_x_atom_text_plain_utf8,
+	ska_x_atom_xsel_data, // Property we receive other clients' clipboard in
+	ska_x_atom_count
+} ska_x_atom_;
+#endif
+
 // ============================================================================
 // Global State
 // ============================================================================
@@ -216,12 +421,41 @@ typedef struct ska_state_t {
 	bool initialized;
 	char error_msg[512];
 	uint64_t start_time;
-
-	ska_window_t* windows[SKA_MAX_WINDOWS];
-	uint32_t window_count;
-	ska_window_id_t next_window_id;
+	ska_fast_clock_t fast_clock;
+
+	// Window registry, see ska_window_alloc. windows[] is dense for iterating,
+	// window_slots resolve ids and window_natives resolve OS handles.
+	ska_window_t**       windows;
+	uint32_t             window_count;
+	uint32_t             window_capacity;
+	ska_window_slot_t*   window_slots;
+	uint32_t             window_slot_count;
+	uint32_t             window_slot_capacity;
+	uint32_t             window_slot_free;      // 1 + first free slot, 0 if none
+	ska_window_native_t* window_natives;        // Open addressing, power of two capacity
+	uint32_t             window_native_count;
+	uint32_t             window_native_capacity;
+	atomic_flag window_list_lock; // Guards the registry against a backend input thread
 
 	ska_event_queue_t event_queue;
+	ska_event_inbox_t event_inbox;
+	bool event_queue_overflowing; // Set while drops are happening, so we warn once per overflow
+	int32_t event_coalesce_threshold; // Queue depth where motion/wheel merge, < 0 never
+	bool event_producer_threaded; // A backend thread produces events and commits them itself
+	ska_stats_counters_t  stats;
+	_Atomic uint64_t      event_disabled;     // Bit per ska_event_ type, see ska_event_set_enabled
+	atomic_flag           event_hook_lock;    // Guards the hooks below, never held while they run
+	_Atomic bool          event_hooked;       // A filter or watch is installed, checked on every post
+	ska_event_filter_fn   event_filter;
+	void*                 event_filter_user;
+	ska_event_watch_t     event_watches[SKA_MAX_EVENT_WATCHES];
+	int32_t               event_watch_count;
+	bool recording;               // ska_record_start() is writing polled events
+	bool replaying;               // ska_replay_start() feeds the queue instead of the platform
+	bool input_thread_requested;  // ska_init_info_t.input_thread, backends without one ignore it
+	bool     frame_open;          // Between ska_frame_begin() and ska_frame_end()
+	uint32_t frame_events;        // Events handed out during the open frame
+	uint64_t frame_pump_ns;       // Pump time during the open frame
 	ska_input_state_t input_state;
 
 	// Platform-specific state
@@ -229,22 +463,56 @@ typedef struct ska_state_t {
 	HINSTANCE hinstance;
 	WNDCLASSEXW window_class;
 	bool window_class_registered;
+	DWORD main_thread_id; // Thread that pumps messages, ska_platform_wake posts to it
 #endif
 
 #ifdef SKA_PLATFORM_LINUX
 	Display* x_display;
 	int32_t x_screen;
 	Window x_root;
-	Atom wm_protocols;
-	Atom wm_delete_window;
-	Atom net_wm_state;
-	Atom net_wm_state_fullscreen;
-	Atom net_wm_state_maximized_vert;
-	Atom net_wm_state_maximized_horz;
-	Atom resource_manager; // For DPI change detection
+	Atom x_atoms[ska_x_atom_count];
 	XIM xim;
 	int32_t xi_opcode;
-	float cached_dpi_scale; // Track DPI changes
+	float cached_dpi_scale; // Xft.dpi scale, parsed at init and on RESOURCE_MANAGER changes
+
+	// Server time correlation, see ska_linux_event_time_ns (producer thread only)
+	bool     x_time_synced;
+	uint32_t x_time_last;      // Last server time seen, for wrap tracking
+	int64_t  x_time_server_ms; // x_time_last unwrapped
+	int64_t  x_time_offset_ns; // Local elapsed ns minus server ns
+	uint64_t x_time_sample_ns; // Local time of the last sample
+	uint64_t x_time_last_ns;   // Last event time handed out
+
+	// Input thread, see ska_linux_x11.c
+	bool            x_input_thread_running;
+	pthread_t       x_input_thread;
+	_Atomic bool    x_input_thread_quit;
+	int             x_input_wake_pipe[2]; // Wakes the input thread (shutdown, new dialog pipe, inbox push)
+	int             x_main_wake_pipe[2];  // Wakes ska_platform_wait_events after a commit or inbox push
+	_Atomic bool    x_main_wake_pending;  // A wake byte is in x_main_wake_pipe
+	_Atomic bool    x_selection_ready;    // x_selection_event holds our SelectionNotify
+
+	// Our clipboard text while we own CLIPBOARD, so requests for it are served
+	// without a round trip. Guarded by window_list_lock like the event translation.
+	char*           x_clipboard_text;
+	size_t          x_clipboard_length;
+	Window          x_clipboard_owner;    // None once another client takes the selection
+	XSelectionEvent x_selection_event;
+
+	// ska_timer_add() deadlines, see ska_linux_timer_arm
+	int             x_timer_fd;
+	uint64_t        x_timer_armed_ns;     // Deadline x_timer_fd is set to, UINT64_MAX disarmed, 0 stale
+
+	// XRandR monitor list, rebuilt by the event producer after RandR or
+	// _NET_WORKAREA changes. x_monitor_lock only covers swapping and copying it.
+	bool                x_rr_available;
+	bool                x_rr_monitors;     // RandR 1.5, XRRGetMonitors is there
+	int32_t             x_rr_event_base;
+	bool                x_monitors_dirty;   // Producer thread only: rebuild after this batch
+	bool                x_monitors_changed; // Producer thread only: post ska_event_display_changed
+	atomic_flag         x_monitor_lock;
+	ska_display_info_t* x_monitors;
+	int32_t             x_monitor_count;
 #endif
 
 #ifdef SKA_PLATFORM_MACOS
@@ -257,21 +525,74 @@ typedef struct ska_state_t {
 	struct android_app* android_app;
 	bool app_has_focus;
 	bool app_is_visible;
+	ALooper* _Atomic    android_wait_looper;  // Looper of the thread in ska_platform_wait_events, NULL until it first waits
+	_Atomic bool        android_wake_pending; // An ALooper_wake() to android_wait_looper is outstanding
 #endif
 
 } ska_state_t;
 
 extern ska_state_t g_ska;
 
+// Bump a ska_stats_counters_t field from any thread
+#define ska_stats_add(field, amount) \
+	atomic_fetch_add_explicit(&g_ska.stats.field, (uint64_t)(amount), memory_order_relaxed)
+// Bump a field only one thread writes, skipping the locked read-modify-write
+#define ska_stats_add_owned(field, amount) \
+	atomic_store_explicit(&g_ska.stats.field, \
+		atomic_load_explicit(&g_ska.stats.field, memory_order_relaxed) + (uint64_t)(amount), memory_order_relaxed)
+
 // ============================================================================
 // Internal Functions
 // ============================================================================
 
 // Common
 void ska_set_error(const char* fmt, ...);
+void* ska_aligned_alloc(size_t alignment, size_t size);
+void  ska_aligned_free(void* ptr);
 ska_window_t* ska_window_alloc(void);
 void ska_window_free(ska_window_t* ref_window);
+void ska_window_registry_free(void); // Once every window is freed, at shutdown
+// Maps an OS handle (HWND, X11 Window, NSWindow*) to its window in O(1).
+// Backends register a window once the handle exists, 0 unregisters it, and
+// ska_window_free drops whatever is left.
+void ska_window_set_native(ska_window_t* ref_window, uintptr_t handle);
+ska_window_t* ska_window_from_native(uintptr_t handle);
+// Held while windows[] changes. A backend input thread holds it while it
+// translates an event, so a window it found stays alive until it is done.
+void ska_window_list_lock(void);
+void ska_window_list_unlock(void);
+// Cheap per-type check so backends can skip translating disabled events
+static inline bool ska_event_type_enabled(ska_event_ type) {
+	return (uint32_t)type >= 64 ||
+		(atomic_load_explicit(&g_ska.event_disabled, memory_order_relaxed) & (1ULL << (uint32_t)type)) == 0;
+}
+// Queue an event from the event producer thread. Posts are staged until the
+// producer calls ska_post_event_commit(), which ska_event_poll() does after
+// pumping; backends that produce on another thread (Android's looper, the X11
+// input thread) set event_producer_threaded and commit after each batch, and
+// the polling thread must then never commit: staged_pos and write_segment
+// belong to the producer alone.
 void ska_post_event(const ska_event_t* event);
+// Like ska_post_event() but without coalescing, for events read back from a
+// recording. Returns false if the queue was full and the event was dropped.
+bool ska_post_replayed_event(const ska_event_t* event);
+void ska_post_event_commit(void);
+// Event producer thread: posts what other threads left in event_inbox, the
+// caller commits. Returns how many events were taken out.
+int32_t ska_post_inbox_events(void);
+
+// Event recording and replay (ska_record.c)
+void    ska_record_events(const ska_event_t* events, int32_t count); // Log events handed to the app
+void    ska_replay_pump(void);     // Queues replayed events that are due, in place of the platform pump
+int32_t ska_replay_wait_ms(void);  // Time until the next replayed event is due
+
+// Timers (ska_timer.c), app thread only
+void     ska_timer_pump(void);              // Posts timers that are due
+uint64_t ska_timer_next_deadline_ns(void);  // Earliest deadline, UINT64_MAX if none
+void     ska_timer_clear(void);
+
+// Frame statistics (ska_frame.c)
+void ska_frame_clear(void);
 
 // Platform-specific initialization
 bool ska_platform_init(void);
@@ -292,6 +613,8 @@ void ska_platform_window_raise(ska_window_t* ref_window);
 void ska_platform_window_get_drawable_size(ska_window_t* ref_window, int32_t* opt_out_width, int32_t* opt_out_height);
 float ska_platform_get_dpi_scale(const ska_window_t* window);
 float ska_platform_get_refresh_rate(const ska_window_t* window);
+int32_t ska_platform_display_count(void);
+bool ska_platform_display_get_info(int32_t index, ska_display_info_t* out_info);
 
 // Platform-specific frame extents (title bar, borders)
 // Returns the size of window decorations: left, right, top (title bar), bottom
@@ -309,6 +632,14 @@ void ska_platform_show_virtual_keyboard(bool visible, ska_text_input_type_ type)
 // Platform-specific event processing
 void ska_platform_pump_events(void);
 
+// Any thread. Gets the event producer to call ska_post_inbox_events() soon,
+// and through it, wakes a ska_platform_wait_events() in progress.
+void ska_platform_wake(void);
+
+// Block until platform events may be available or timeout_ms elapses (-1 = forever).
+// Spurious returns are fine, callers re-poll and recompute the remaining timeout.
+void ska_platform_wait_events(int32_t timeout_ms);
+
 // Vulkan support
 const char** ska_platform_vk_get_instance_extensions(uint32_t* out_count);
 bool         ska_platform_vk_create_surface         (const ska_window_t* window, VkInstance instance, VkSurfaceKHR* out_surface);
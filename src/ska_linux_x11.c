@@ -11,7 +11,10 @@
 #include <X11/Xresource.h>
 #include <locale.h>
 #include <sys/select.h>
+#include <poll.h>
+#include <fcntl.h>
 #include <unistd.h>
+#include <sys/timerfd.h>
 
 // Scancode translation table (X11 keycodes to ska_scancode_)
 static ska_scancode_ ska_x11_scancode_table[256];
@@ -95,28 +98,192 @@ static void ska_init_scancode_table(void) {
 }
 
 static ska_window_t* ska_find_window_by_xwindow(Window xwin) {
-	for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-		if (g_ska.windows[i] && g_ska.windows[i]->xwindow == xwin) {
-			return g_ska.windows[i];
-		}
+	return ska_window_from_native((uintptr_t)xwin); // None is never registered
+}
+
+// Explicit flushes and syncs go through these so ska_stats_get() can count
+// them along with the requests sent so far. Display locking nests, so these
+// are fine to call from the input thread while it holds the display.
+static void ska_linux_note_requests(void) {
+	XLockDisplay(g_ska.x_display);
+	unsigned long next = XNextRequest(g_ska.x_display);
+	XUnlockDisplay(g_ska.x_display);
+	atomic_store_explicit(&g_ska.stats.display_requests, next > 0 ? (uint64_t)next - 1 : 0, memory_order_relaxed);
+}
+
+static void ska_linux_flush(void) {
+	XFlush(g_ska.x_display);
+	ska_stats_add(display_flushes, 1);
+	ska_linux_note_requests();
+}
+
+// Every Xlib call sk_app makes that blocks on a server reply is marked with
+// SKA_X_ROUND_TRIP, counted in ska_stats_t.display_round_trips and, through
+// it, per frame in ska_frame_stats_t. Building with SKA_X11_AUDIT also keeps
+// a count per call site, logs each site the first time it blocks and prints
+// the table at shutdown.
+#define SKA_X_ROUND_TRIP(call) ska_linux_round_trip(call, __func__)
+
+#ifdef SKA_X11_AUDIT
+#define SKA_X11_AUDIT_SITES 64
+
+typedef struct ska_linux_audit_site_t {
+	const char* call;
+	const char* function;
+	uint64_t    count;
+} ska_linux_audit_site_t;
+
+static ska_linux_audit_site_t g_ska_audit_sites[SKA_X11_AUDIT_SITES];
+static int32_t                g_ska_audit_site_count = 0;
+static atomic_flag            g_ska_audit_lock = ATOMIC_FLAG_INIT; // App and input thread both block
+
+static void ska_linux_audit_record(const char* call, const char* function) {
+	while (atomic_flag_test_and_set_explicit(&g_ska_audit_lock, memory_order_acquire)) {}
+
+	// Names are literals and __func__, so pointers identify the site
+	int32_t i = 0;
+	while (i < g_ska_audit_site_count &&
+	       (g_ska_audit_sites[i].call != call || g_ska_audit_sites[i].function != function)) {
+		i++;
 	}
-	return NULL;
+	bool first = false;
+	if (i == g_ska_audit_site_count && i < SKA_X11_AUDIT_SITES) {
+		g_ska_audit_sites[i].call     = call;
+		g_ska_audit_sites[i].function = function;
+		g_ska_audit_site_count++;
+		first = true;
+	}
+	if (i < g_ska_audit_site_count) {
+		g_ska_audit_sites[i].count++;
+	}
+
+	atomic_flag_clear_explicit(&g_ska_audit_lock, memory_order_release);
+
+	if (first) {
+		ska_log(ska_log_warn, "X11 round trip: %s in %s", call, function);
+	}
+}
+
+static void ska_linux_audit_report(void) {
+	if (g_ska_audit_site_count == 0) {
+		ska_log(ska_log_info, "X11 round trips: none");
+		return;
+	}
+	ska_log(ska_log_info, "X11 round trips by call site:");
+	for (int32_t i = 0; i < g_ska_audit_site_count; i++) {
+		ska_log(ska_log_info, "  %8llu  %s in %s",
+			(unsigned long long)g_ska_audit_sites[i].count,
+			g_ska_audit_sites[i].call,
+			g_ska_audit_sites[i].function);
+	}
+	g_ska_audit_site_count = 0;
+}
+#endif
+
+static void ska_linux_round_trip(const char* call, const char* function) {
+	ska_stats_add(display_round_trips, 1);
+#ifdef SKA_X11_AUDIT
+	ska_linux_audit_record(call, function);
+#else
+	(void)call;
+	(void)function;
+#endif
 }
 
+static void ska_linux_sync(void) {
+	SKA_X_ROUND_TRIP("XSync");
+	XSync(g_ska.x_display, False);
+	ska_stats_add(display_flushes, 1);
+	ska_linux_note_requests();
+}
+
+// Names for ska_x_atom_, interned by ska_platform_init
+static const char* ska_x_atom_names[ska_x_atom_count] = {
+	[ska_x_atom_wm_protocols]                = "WM_PROTOCOLS",
+	[ska_x_atom_wm_delete_window]            = "WM_DELETE_WINDOW",
+	[ska_x_atom_net_wm_state]                = "_NET_WM_STATE",
+	[ska_x_atom_net_wm_state_fullscreen]     = "_NET_WM_STATE_FULLSCREEN",
+	[ska_x_atom_net_wm_state_maximized_vert] = "_NET_WM_STATE_MAXIMIZED_VERT",
+	[ska_x_atom_net_wm_state_maximized_horz] = "_NET_WM_STATE_MAXIMIZED_HORZ",
+	[ska_x_atom_net_wm_pid]                  = "_NET_WM_PID",
+	[ska_x_atom_net_wm_icon]                 = "_NET_WM_ICON",
+	[ska_x_atom_net_frame_extents]           = "_NET_FRAME_EXTENTS",
+	[ska_x_atom_net_workarea]                = "_NET_WORKAREA",
+	[ska_x_atom_motif_wm_hints]              = "_MOTIF_WM_HINTS",
+	[ska_x_atom_resource_manager]            = "RESOURCE_MANAGER",
+	[ska_x_atom_clipboard]                   = "CLIPBOARD",
+	[ska_x_atom_targets]                     = "TARGETS",
+	[ska_x_atom_text]                        = "TEXT",
+	[ska_x_atom_utf8_string]                 = "UTF8_STRING",
+	[ska_x_atom_text_plain]                  = "text/plain",
+	[ska_x_atom_text_plain_utf8]             = "text/plain;charset=utf-8",
+	[ska_x_atom_xsel_data]                   = "XSEL_DATA",
+};
+
 // Forward declaration for file dialog check
 static void ska_linux_check_file_dialog(void);
 
+// Xft.dpi parsing, defined with the window getters
+static float ska_linux_query_dpi_scale(const char* opt_resources);
+
+// Monitor list, defined with the window getters
+static int32_t ska_linux_monitors_build(ska_display_info_t** out_monitors);
+
+// Drops our clipboard copy, caller holds window_list_lock (or is shutting down)
+static void ska_linux_clipboard_release(void) {
+	free(g_ska.x_clipboard_text);
+	g_ska.x_clipboard_text   = NULL;
+	g_ska.x_clipboard_length = 0;
+	g_ska.x_clipboard_owner  = None;
+}
+
+// Input thread, defined after ska_platform_wait_events
+static bool ska_linux_input_thread_start(void);
+static void ska_linux_input_thread_stop(void);
+static void ska_linux_input_thread_wake(void);
+static void ska_linux_pipe_drain(int fd);
+static bool ska_linux_pipe_create(int fds[2]);
+
 bool ska_platform_init(void) {
 	// Set locale for X11
 	setlocale(LC_ALL, "");
 	XSetLocaleModifiers("");
 
+	// Xlib needs its locking turned on before the display is opened if a
+	// second thread is going to read from it
+	if (g_ska.input_thread_requested && !XInitThreads()) {
+		ska_log(ska_log_warn, "XInitThreads failed, reading input on the app thread");
+		g_ska.input_thread_requested = false;
+	}
+
 	g_ska.x_display = XOpenDisplay(NULL);
 	if (!g_ska.x_display) {
 		ska_set_error("Failed to open X11 display");
 		return false;
 	}
 
+	// All atoms in one round trip, nothing after init needs to intern
+	SKA_X_ROUND_TRIP("XInternAtoms");
+	if (!XInternAtoms(g_ska.x_display, (char**)ska_x_atom_names, ska_x_atom_count, False, g_ska.x_atoms)) {
+		ska_set_error("Failed to intern X11 atoms");
+		XCloseDisplay(g_ska.x_display);
+		g_ska.x_display = NULL;
+		return false;
+	}
+
+	// Lets other threads interrupt ska_platform_wait_events, see ska_platform_wake
+	if (!ska_linux_pipe_create(g_ska.x_main_wake_pipe)) {
+		ska_set_error("Failed to create wake pipe");
+		XCloseDisplay(g_ska.x_display);
+		g_ska.x_display = NULL;
+		return false;
+	}
+	atomic_store(&g_ska.x_main_wake_pending, false);
+
+	// Without it waits still end on time, rounded up to the next millisecond
+	g_ska.x_timer_fd       = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	g_ska.x_timer_armed_ns = UINT64_MAX;
+
 	g_ska.x_screen = DefaultScreen(g_ska.x_display);
 	g_ska.x_root = RootWindow(g_ska.x_display, g_ska.x_screen);
 
@@ -129,34 +296,51 @@ bool ska_platform_init(void) {
 	// Initialize Xrm database (required before using XrmGetResource for DPI queries)
 	XrmInitialize();
 
-	// Get WM atoms
-	g_ska.wm_protocols                = XInternAtom(g_ska.x_display, "WM_PROTOCOLS", False);
-	g_ska.wm_delete_window            = XInternAtom(g_ska.x_display, "WM_DELETE_WINDOW", False);
-	g_ska.net_wm_state                = XInternAtom(g_ska.x_display, "_NET_WM_STATE", False);
-	g_ska.net_wm_state_fullscreen     = XInternAtom(g_ska.x_display, "_NET_WM_STATE_FULLSCREEN", False);
-	g_ska.net_wm_state_maximized_vert = XInternAtom(g_ska.x_display, "_NET_WM_STATE_MAXIMIZED_VERT", False);
-	g_ska.net_wm_state_maximized_horz = XInternAtom(g_ska.x_display, "_NET_WM_STATE_MAXIMIZED_HORZ", False);
-	g_ska.resource_manager            = XInternAtom(g_ska.x_display, "RESOURCE_MANAGER", False);
-
 	// Watch root window for property changes (for DPI change detection via xrdb)
 	XSelectInput(g_ska.x_display, g_ska.x_root, PropertyChangeMask);
 
-	// Cache initial DPI scale
-	g_ska.cached_dpi_scale = 0.0f; // Will be set on first window creation
+	// Parse the DPI scale once, windows copy it and PropertyNotify keeps it current
+	g_ska.cached_dpi_scale = ska_linux_query_dpi_scale(XResourceManagerString(g_ska.x_display));
+
+	// XRandR 1.3 for the monitor list, 1.5 adds XRRGetMonitors
+	int32_t rr_error_base, rr_major = 0, rr_minor = 0;
+	SKA_X_ROUND_TRIP("XRRQueryExtension");
+	if (XRRQueryExtension(g_ska.x_display, &g_ska.x_rr_event_base, &rr_error_base)) {
+		SKA_X_ROUND_TRIP("XRRQueryVersion");
+		if (XRRQueryVersion(g_ska.x_display, &rr_major, &rr_minor) && (rr_major > 1 || rr_minor >= 3)) {
+			g_ska.x_rr_available = true;
+			g_ska.x_rr_monitors  = rr_major > 1 || rr_minor >= 5;
+			XRRSelectInput(g_ska.x_display, g_ska.x_root, RRScreenChangeNotifyMask | RRCrtcChangeNotifyMask | RROutputChangeNotifyMask);
+		}
+	}
+	if (!g_ska.x_rr_available) {
+		ska_log(ska_log_warn, "XRandR 1.3 not available, treating the screen as one display");
+	}
+	g_ska.x_monitor_count = ska_linux_monitors_build(&g_ska.x_monitors);
 
 	// Initialize scancode table
 	ska_init_scancode_table();
 
 	// Check for XInput2
 	int32_t xi_event, xi_error;
+	SKA_X_ROUND_TRIP("XQueryExtension");
 	if (!XQueryExtension(g_ska.x_display, "XInputExtension", &g_ska.xi_opcode, &xi_event, &xi_error)) {
 		ska_log(ska_log_warn, "XInput extension not available");
 	}
 
+	if (g_ska.input_thread_requested && !ska_linux_input_thread_start()) {
+		ska_log(ska_log_warn, "Failed to start the input thread, reading input on the app thread");
+	}
+
 	return true;
 }
 
 void ska_platform_shutdown(void) {
+	ska_linux_input_thread_stop();
+#ifdef SKA_X11_AUDIT
+	ska_linux_audit_report();
+#endif
+
 	if (g_ska.xim) {
 		XCloseIM(g_ska.xim);
 		g_ska.xim = NULL;
@@ -166,6 +350,16 @@ void ska_platform_shutdown(void) {
 		XCloseDisplay(g_ska.x_display);
 		g_ska.x_display = NULL;
 	}
+	ska_linux_clipboard_release();
+	free(g_ska.x_monitors);
+	g_ska.x_monitors      = NULL;
+	g_ska.x_monitor_count = 0;
+
+	close(g_ska.x_main_wake_pipe[0]);
+	close(g_ska.x_main_wake_pipe[1]);
+	if (g_ska.x_timer_fd >= 0) {
+		close(g_ska.x_timer_fd);
+	}
 }
 
 bool ska_platform_window_create(
@@ -183,6 +377,7 @@ bool ska_platform_window_create(
 					EnterWindowMask | LeaveWindowMask |
 					FocusChangeMask |
 					StructureNotifyMask |
+					PropertyChangeMask | // _NET_FRAME_EXTENTS updates
 					ExposureMask;
 	wa.colormap = XCreateColormap(g_ska.x_display, g_ska.x_root,
 								   DefaultVisual(g_ska.x_display, g_ska.x_screen),
@@ -212,6 +407,7 @@ bool ska_platform_window_create(
 		ska_set_error("Failed to create X11 window");
 		return false;
 	}
+	ska_window_set_native(window, (uintptr_t)window->xwindow);
 
 	// Set window title
 	XStoreName(g_ska.x_display, window->xwindow, title);
@@ -228,7 +424,7 @@ bool ska_platform_window_create(
 	}
 
 	// Set WM protocols
-	XSetWMProtocols(g_ska.x_display, window->xwindow, &g_ska.wm_delete_window, 1);
+	XSetWMProtocols(g_ska.x_display, window->xwindow, &g_ska.x_atoms[ska_x_atom_wm_delete_window], 1);
 
 	// Create input context
 	if (g_ska.xim) {
@@ -258,7 +454,7 @@ bool ska_platform_window_create(
 		hints.flags = 2; // MWM_HINTS_DECORATIONS
 		hints.decorations = 0;
 
-		Atom mwm_hints = XInternAtom(g_ska.x_display, "_MOTIF_WM_HINTS", False);
+		Atom mwm_hints = g_ska.x_atoms[ska_x_atom_motif_wm_hints];
 		XChangeProperty(g_ska.x_display, window->xwindow, mwm_hints, mwm_hints,
 					   32, PropModeReplace, (unsigned char*)&hints, 5);
 	}
@@ -277,35 +473,45 @@ bool ska_platform_window_create(
 	}
 
 	// Ensure it knows its process id
-	Atom  net_wm_pid = XInternAtom(g_ska.x_display, "_NET_WM_PID", False);
+	Atom  net_wm_pid = g_ska.x_atoms[ska_x_atom_net_wm_pid];
 	pid_t pid        = getpid();
 	XChangeProperty(g_ska.x_display, window->xwindow, net_wm_pid, XA_CARDINAL, 32, PropModeReplace, (unsigned char*)&pid, 1);
 
+	window->parent = g_ska.x_root;
 	window->x = x;
 	window->y = y;
 	window->width = w;
 	window->height = h;
 	window->drawable_width = w;
 	window->drawable_height = h;
-	window->dpi_scale = ska_platform_get_dpi_scale(window);
-
-	// Cache DPI scale for change detection (first window sets it)
-	if (g_ska.cached_dpi_scale == 0.0f) {
-		g_ska.cached_dpi_scale = window->dpi_scale;
-	}
+	window->dpi_scale = g_ska.cached_dpi_scale;
 
 	return true;
 }
 
 void ska_platform_window_destroy(ska_window_t* window) {
+	// The input thread may be translating an event for this window with the
+	// display locked; take the locks in its order (display, then window list)
+	// and unhook the window so it stops matching incoming events
+	XLockDisplay(g_ska.x_display);
+	ska_window_set_native(window, 0); // Takes the window list lock itself
+	ska_window_list_lock();
 	if (window->xic) {
 		XDestroyIC(window->xic);
+		window->xic = NULL;
 	}
 
 	if (window->xwindow) {
+		// The server drops a destroyed owner's selection without telling it
+		if (window->xwindow == g_ska.x_clipboard_owner) {
+			ska_linux_clipboard_release();
+		}
 		XDestroyWindow(g_ska.x_display, window->xwindow);
-		XFlush(g_ska.x_display);
+		ska_linux_flush();
+		window->xwindow = None;
 	}
+	ska_window_list_unlock();
+	XUnlockDisplay(g_ska.x_display);
 }
 
 void ska_platform_window_set_title(ska_window_t* window, const char* title) {
@@ -315,31 +521,41 @@ void ska_platform_window_set_title(ska_window_t* window, const char* title) {
 	window->title = strdup(title);
 	XStoreName(g_ska.x_display, window->xwindow, title);
 	XSetIconName(g_ska.x_display, window->xwindow, title);
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
+}
+
+// Re-reads _NET_FRAME_EXTENTS after the window manager changed it. Getters
+// use window->frame_extents, so this is the only place that asks the server.
+static void ska_linux_update_frame_extents(ska_window_t* window) {
+	int32_t values[4] = {0};
+	Atom    actual_type;
+	int32_t actual_format;
+	unsigned long  nitems, bytes_after;
+	unsigned char* data = NULL;
+
+	SKA_X_ROUND_TRIP("XGetWindowProperty");
+	if (XGetWindowProperty(g_ska.x_display, window->xwindow, g_ska.x_atoms[ska_x_atom_net_frame_extents],
+	                       0, 4, False, XA_CARDINAL,
+	                       &actual_type, &actual_format, &nitems, &bytes_after, &data) == Success) {
+		if (data && nitems == 4) {
+			long* extents = (long*)data;
+			for (int32_t i = 0; i < 4; i++) {
+				values[i] = (int32_t)extents[i];
+			}
+		}
+		if (data) XFree(data);
+	}
+	memcpy(window->frame_extents, values, sizeof(values));
 }
 
 void ska_platform_get_frame_extents(const ska_window_t* window, int32_t* out_left, int32_t* out_right, int32_t* out_top, int32_t* out_bottom) {
 	int32_t left = 0, right = 0, top = 0, bottom = 0;
 
 	if (window && window->xwindow) {
-		Atom net_frame_extents = XInternAtom(g_ska.x_display, "_NET_FRAME_EXTENTS", False);
-		Atom actual_type;
-		int32_t actual_format;
-		unsigned long nitems, bytes_after;
-		unsigned char* data = NULL;
-
-		if (XGetWindowProperty(g_ska.x_display, window->xwindow, net_frame_extents,
-		                       0, 4, False, XA_CARDINAL,
-		                       &actual_type, &actual_format, &nitems, &bytes_after, &data) == Success) {
-			if (data && nitems == 4) {
-				long* extents = (long*)data;
-				left   = (int32_t)extents[0];
-				right  = (int32_t)extents[1];
-				top    = (int32_t)extents[2];
-				bottom = (int32_t)extents[3];
-			}
-			if (data) XFree(data);
-		}
+		left   = window->frame_extents[0];
+		right  = window->frame_extents[1];
+		top    = window->frame_extents[2];
+		bottom = window->frame_extents[3];
 	}
 
 	if (out_left)   *out_left   = left;
@@ -350,7 +566,7 @@ void ska_platform_get_frame_extents(const ska_window_t* window, int32_t* out_lef
 
 void ska_platform_window_set_frame_position(ska_window_t* window, int32_t x, int32_t y) {
 	XMoveWindow(g_ska.x_display, window->xwindow, x, y);
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 
 	// Update cached content position
 	int32_t left, top;
@@ -361,18 +577,18 @@ void ska_platform_window_set_frame_position(ska_window_t* window, int32_t x, int
 
 void ska_platform_window_set_frame_size(ska_window_t* window, int32_t w, int32_t h) {
 	XResizeWindow(g_ska.x_display, window->xwindow, w, h);
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 }
 
 void ska_platform_window_show(ska_window_t* window) {
 	XMapWindow(g_ska.x_display, window->xwindow);
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 	window->is_visible = true;
 }
 
 void ska_platform_window_hide(ska_window_t* window) {
 	XUnmapWindow(g_ska.x_display, window->xwindow);
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 	window->is_visible = false;
 }
 
@@ -380,20 +596,20 @@ void ska_platform_window_maximize(ska_window_t* window) {
 	XEvent event = {0};
 	event.type = ClientMessage;
 	event.xclient.window = window->xwindow;
-	event.xclient.message_type = g_ska.net_wm_state;
+	event.xclient.message_type = g_ska.x_atoms[ska_x_atom_net_wm_state];
 	event.xclient.format = 32;
 	event.xclient.data.l[0] = 1; // _NET_WM_STATE_ADD
-	event.xclient.data.l[1] = g_ska.net_wm_state_maximized_vert;
-	event.xclient.data.l[2] = g_ska.net_wm_state_maximized_horz;
+	event.xclient.data.l[1] = g_ska.x_atoms[ska_x_atom_net_wm_state_maximized_vert];
+	event.xclient.data.l[2] = g_ska.x_atoms[ska_x_atom_net_wm_state_maximized_horz];
 
 	XSendEvent(g_ska.x_display, g_ska.x_root, False,
 			   SubstructureNotifyMask | SubstructureRedirectMask, &event);
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 }
 
 void ska_platform_window_minimize(ska_window_t* window) {
 	XIconifyWindow(g_ska.x_display, window->xwindow, g_ska.x_screen);
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 }
 
 void ska_platform_window_restore(ska_window_t* window) {
@@ -401,18 +617,18 @@ void ska_platform_window_restore(ska_window_t* window) {
 	XEvent event = {0};
 	event.type = ClientMessage;
 	event.xclient.window = window->xwindow;
-	event.xclient.message_type = g_ska.net_wm_state;
+	event.xclient.message_type = g_ska.x_atoms[ska_x_atom_net_wm_state];
 	event.xclient.format = 32;
 	event.xclient.data.l[0] = 0; // _NET_WM_STATE_REMOVE
-	event.xclient.data.l[1] = g_ska.net_wm_state_maximized_vert;
-	event.xclient.data.l[2] = g_ska.net_wm_state_maximized_horz;
+	event.xclient.data.l[1] = g_ska.x_atoms[ska_x_atom_net_wm_state_maximized_vert];
+	event.xclient.data.l[2] = g_ska.x_atoms[ska_x_atom_net_wm_state_maximized_horz];
 
 	XSendEvent(g_ska.x_display, g_ska.x_root, False,
 			   SubstructureNotifyMask | SubstructureRedirectMask, &event);
 
 	// Then ensure window is mapped (in case it was minimized)
 	XMapWindow(g_ska.x_display, window->xwindow);
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 }
 
 void ska_platform_window_raise(ska_window_t* window) {
@@ -420,15 +636,16 @@ void ska_platform_window_raise(ska_window_t* window) {
 	// Only set focus if window is visible and actually mapped
 	if (window->is_visible) {
 		// Sync and verify the window is actually mapped before setting focus
-		XSync(g_ska.x_display, False);
+		ska_linux_sync();
 
 		XWindowAttributes attrs;
+		SKA_X_ROUND_TRIP("XGetWindowAttributes");
 		if (XGetWindowAttributes(g_ska.x_display, window->xwindow, &attrs) &&
 		    attrs.map_state == IsViewable) {
 			XSetInputFocus(g_ska.x_display, window->xwindow, RevertToPointerRoot, CurrentTime);
 		}
 	}
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 }
 
 void ska_platform_window_get_drawable_size(ska_window_t* window, int32_t* opt_out_width, int32_t* opt_out_height) {
@@ -439,13 +656,11 @@ void ska_platform_window_get_drawable_size(ska_window_t* window, int32_t* opt_ou
 	(void)opt_out_height;
 }
 
-float ska_platform_get_dpi_scale(const ska_window_t* window) {
-	(void)window;
-
-	// Query Xft.dpi from Xresources (this is how GNOME/KDE/etc communicate scaling)
-	char* resource_string = XResourceManagerString(g_ska.x_display);
-	if (resource_string) {
-		XrmDatabase db = XrmGetStringDatabase(resource_string);
+// Scale from an Xresources string (Xft.dpi is how GNOME/KDE/etc communicate
+// scaling). Parsing builds a whole Xrm database, so callers cache the result.
+static float ska_linux_query_dpi_scale(const char* opt_resources) {
+	if (opt_resources) {
+		XrmDatabase db = XrmGetStringDatabase(opt_resources);
 		if (db) {
 			XrmValue value;
 			char* type = NULL;
@@ -478,25 +693,299 @@ float ska_platform_get_dpi_scale(const ska_window_t* window) {
 	return 1.0f;
 }
 
-float ska_platform_get_refresh_rate(const ska_window_t* window) {
-	(void)window;
+// XResourceManagerString() is the copy Xlib took when the display opened, so
+// after a change the property has to be read back from the root window
+static float ska_linux_reload_dpi_scale(void) {
+	Atom           actual_type;
+	int32_t        actual_format;
+	unsigned long  nitems, bytes_after;
+	unsigned char* data      = NULL;
+	const char*    resources = NULL;
+
+	SKA_X_ROUND_TRIP("XGetWindowProperty");
+	if (XGetWindowProperty(g_ska.x_display, g_ska.x_root, g_ska.x_atoms[ska_x_atom_resource_manager],
+	                       0, 0x7fffffff / 4, False, XA_STRING,
+	                       &actual_type, &actual_format, &nitems, &bytes_after, &data) == Success &&
+	    actual_type == XA_STRING && actual_format == 8) {
+		resources = (const char*)data; // Xlib null-terminates 8-bit property data
+	}
+	float scale = ska_linux_query_dpi_scale(resources);
+	if (data) XFree(data);
+	return scale;
+}
+
+float ska_platform_get_dpi_scale(const ska_window_t* window) {
+	return window ? window->dpi_scale : g_ska.cached_dpi_scale;
+}
+
+// ========== Monitors ==========
+//
+// Built from XRandR at init and rebuilt only after RandR or _NET_WORKAREA
+// change events, once per batch. Probing outputs can take milliseconds, so
+// display and refresh rate queries read the copy in g_ska.x_monitors.
+
+static void ska_linux_monitor_lock(void) {
+	while (atomic_flag_test_and_set_explicit(&g_ska.x_monitor_lock, memory_order_acquire)) {
+		ska_time_sleep(0);
+	}
+}
+
+static void ska_linux_monitor_unlock(void) {
+	atomic_flag_clear_explicit(&g_ska.x_monitor_lock, memory_order_release);
+}
+
+static float ska_linux_mode_refresh_rate(const XRRScreenResources* resources, RRMode mode) {
+	for (int32_t i = 0; i < resources->nmode; i++) {
+		const XRRModeInfo* info = &resources->modes[i];
+		if (info->id != mode) {
+			continue;
+		}
+
+		double v_total = (double)info->vTotal;
+		if (info->modeFlags & RR_DoubleScan) v_total *= 2.0;
+		if (info->modeFlags & RR_Interlace)  v_total /= 2.0;
+		if (info->hTotal == 0 || v_total <= 0.0) {
+			return 0.0f;
+		}
+		return (float)((double)info->dotClock / ((double)info->hTotal * v_total));
+	}
+	return 0.0f;
+}
+
+// Fills name and refresh rate from output, plus the bounds of its CRTC when
+// set_bounds is true. Returns false if the output isn't driving anything.
+static bool ska_linux_monitor_from_output(XRRScreenResources* resources, RROutput output, bool set_bounds, ska_display_info_t* ref_info) {
+	SKA_X_ROUND_TRIP("XRRGetOutputInfo");
+	XRROutputInfo* output_info = XRRGetOutputInfo(g_ska.x_display, resources, output);
+	if (!output_info) {
+		return false;
+	}
+	snprintf(ref_info->name, sizeof(ref_info->name), "%.*s", output_info->nameLen, output_info->name);
+	RRCrtc crtc = output_info->crtc;
+	XRRFreeOutputInfo(output_info);
+	if (crtc == None) {
+		return false;
+	}
+
+	SKA_X_ROUND_TRIP("XRRGetCrtcInfo");
+	XRRCrtcInfo* crtc_info = XRRGetCrtcInfo(g_ska.x_display, resources, crtc);
+	if (!crtc_info) {
+		return false;
+	}
+	bool active = crtc_info->mode != None;
+	ref_info->refresh_rate = ska_linux_mode_refresh_rate(resources, crtc_info->mode);
+	if (set_bounds) {
+		ref_info->x      = crtc_info->x;
+		ref_info->y      = crtc_info->y;
+		ref_info->width  = (int32_t)crtc_info->width;
+		ref_info->height = (int32_t)crtc_info->height;
+	}
+	XRRFreeCrtcInfo(crtc_info);
+	return active;
+}
 
-	// Use XRandR to get the current screen refresh rate
-	XRRScreenConfiguration* config = XRRGetScreenInfo(g_ska.x_display, g_ska.x_root);
-	if (!config) {
-		return 0.0f;
+// _NET_WORKAREA of the first desktop, window managers give them all the same one
+static bool ska_linux_get_workarea(int32_t out_area[4]) {
+	Atom           actual_type;
+	int32_t        actual_format;
+	unsigned long  nitems, bytes_after;
+	unsigned char* data  = NULL;
+	bool           found = false;
+
+	SKA_X_ROUND_TRIP("XGetWindowProperty");
+	if (XGetWindowProperty(g_ska.x_display, g_ska.x_root, g_ska.x_atoms[ska_x_atom_net_workarea],
+	                       0, 4, False, XA_CARDINAL,
+	                       &actual_type, &actual_format, &nitems, &bytes_after, &data) == Success) {
+		if (data && actual_format == 32 && nitems >= 4) {
+			long* area = (long*)data;
+			for (int32_t i = 0; i < 4; i++) {
+				out_area[i] = (int32_t)area[i];
+			}
+			found = out_area[2] > 0 && out_area[3] > 0;
+		}
+		if (data) XFree(data);
 	}
+	return found;
+}
 
-	short rate = XRRConfigCurrentRate(config);
-	XRRFreeScreenConfigInfo(config);
+// Asks the server for the current monitors, caller frees *out_monitors.
+// Falls back to the whole screen as one monitor, so the count is only 0 when
+// out of memory.
+static int32_t ska_linux_monitors_build(ska_display_info_t** out_monitors) {
+	ska_display_info_t* monitors = NULL;
+	int32_t             count    = 0;
+
+	if (g_ska.x_rr_available) {
+		SKA_X_ROUND_TRIP("XRRGetScreenResourcesCurrent");
+		XRRScreenResources* resources = XRRGetScreenResourcesCurrent(g_ska.x_display, g_ska.x_root);
+		if (resources && g_ska.x_rr_monitors) {
+			// Monitors already merge outputs showing the same area
+			int32_t monitor_count = 0;
+			SKA_X_ROUND_TRIP("XRRGetMonitors");
+			XRRMonitorInfo* list = XRRGetMonitors(g_ska.x_display, g_ska.x_root, True, &monitor_count);
+			if (list && monitor_count > 0) {
+				monitors = (ska_display_info_t*)calloc((size_t)monitor_count, sizeof(ska_display_info_t));
+			}
+			for (int32_t i = 0; monitors && i < monitor_count; i++) {
+				ska_display_info_t* info = &monitors[count++];
+				info->x          = list[i].x;
+				info->y          = list[i].y;
+				info->width      = list[i].width;
+				info->height     = list[i].height;
+				info->is_primary = list[i].primary != 0;
+				if (list[i].noutput > 0) {
+					ska_linux_monitor_from_output(resources, list[i].outputs[0], false, info);
+				}
+			}
+			if (list) XRRFreeMonitors(list);
+		} else if (resources) {
+			SKA_X_ROUND_TRIP("XRRGetOutputPrimary");
+			RROutput primary = XRRGetOutputPrimary(g_ska.x_display, g_ska.x_root);
+			if (resources->noutput > 0) {
+				monitors = (ska_display_info_t*)calloc((size_t)resources->noutput, sizeof(ska_display_info_t));
+			}
+			for (int32_t i = 0; monitors && i < resources->noutput; i++) {
+				ska_display_info_t* info = &monitors[count];
+				if (!ska_linux_monitor_from_output(resources, resources->outputs[i], true, info)) {
+					memset(info, 0, sizeof(*info));
+					continue;
+				}
 
-	return (float)rate;
+				// Cloned outputs share a CRTC, keep the first of them
+				bool clone = false;
+				for (int32_t m = 0; m < count && !clone; m++) {
+					clone = monitors[m].x == info->x && monitors[m].y == info->y &&
+					        monitors[m].width == info->width && monitors[m].height == info->height;
+				}
+				if (clone) {
+					if (resources->outputs[i] == primary) monitors[count - 1].is_primary = true;
+					memset(info, 0, sizeof(*info));
+					continue;
+				}
+				info->is_primary = resources->outputs[i] == primary;
+				count++;
+			}
+		}
+		if (resources) XRRFreeScreenResources(resources);
+	}
+
+	if (count == 0) {
+		free(monitors);
+		monitors = (ska_display_info_t*)calloc(1, sizeof(ska_display_info_t));
+		if (!monitors) {
+			*out_monitors = NULL;
+			return 0;
+		}
+		monitors[0].width      = DisplayWidth (g_ska.x_display, g_ska.x_screen);
+		monitors[0].height     = DisplayHeight(g_ska.x_display, g_ska.x_screen);
+		monitors[0].is_primary = true;
+		count = 1;
+	}
+
+	// The work area spans all monitors, each gets its share of it
+	int32_t area[4] = {0};
+	bool    has_area = ska_linux_get_workarea(area);
+	for (int32_t i = 0; i < count; i++) {
+		ska_display_info_t* info = &monitors[i];
+		info->dpi_scale   = g_ska.cached_dpi_scale; // Xft.dpi is one value for the whole screen
+		info->work_x      = info->x;
+		info->work_y      = info->y;
+		info->work_width  = info->width;
+		info->work_height = info->height;
+		if (has_area) {
+			int32_t left   = info->x > area[0] ? info->x : area[0];
+			int32_t top    = info->y > area[1] ? info->y : area[1];
+			int32_t right  = info->x + info->width  < area[0] + area[2] ? info->x + info->width  : area[0] + area[2];
+			int32_t bottom = info->y + info->height < area[1] + area[3] ? info->y + info->height : area[1] + area[3];
+			if (right > left && bottom > top) {
+				info->work_x      = left;
+				info->work_y      = top;
+				info->work_width  = right - left;
+				info->work_height = bottom - top;
+			}
+		}
+	}
+
+	*out_monitors = monitors;
+	return count;
+}
+
+// Rebuilds the monitor list if events in this batch changed it
+static void ska_linux_monitors_update(void) {
+	if (!g_ska.x_monitors_dirty) {
+		return;
+	}
+	g_ska.x_monitors_dirty = false;
+
+	ska_display_info_t* monitors = NULL;
+	int32_t             count    = ska_linux_monitors_build(&monitors);
+	if (!monitors) {
+		return; // Out of memory, keep the old list
+	}
+
+	ska_linux_monitor_lock();
+	ska_display_info_t* old = g_ska.x_monitors;
+	bool changed = count != g_ska.x_monitor_count || !old || memcmp(old, monitors, (size_t)count * sizeof(ska_display_info_t)) != 0;
+	g_ska.x_monitors      = monitors;
+	g_ska.x_monitor_count = count;
+	ska_linux_monitor_unlock();
+	free(old);
+
+	if (changed) {
+		g_ska.x_monitors_changed = true;
+	}
+}
+
+int32_t ska_platform_display_count(void) {
+	ska_linux_monitor_lock();
+	int32_t count = g_ska.x_monitor_count;
+	ska_linux_monitor_unlock();
+	return count;
+}
+
+bool ska_platform_display_get_info(int32_t index, ska_display_info_t* out_info) {
+	ska_linux_monitor_lock();
+	bool valid = index >= 0 && index < g_ska.x_monitor_count;
+	if (valid) {
+		*out_info = g_ska.x_monitors[index];
+	}
+	ska_linux_monitor_unlock();
+	return valid;
+}
+
+float ska_platform_get_refresh_rate(const ska_window_t* window) {
+	float   rate = 0.0f;
+	int64_t best = -1;
+
+	// The monitor with the largest share of the window, the primary one
+	// when it's on none of them
+	ska_linux_monitor_lock();
+	for (int32_t i = 0; i < g_ska.x_monitor_count; i++) {
+		const ska_display_info_t* info = &g_ska.x_monitors[i];
+		int64_t overlap = 0;
+		if (window) {
+			int32_t left   = window->x > info->x ? window->x : info->x;
+			int32_t top    = window->y > info->y ? window->y : info->y;
+			int32_t right  = window->x + window->width  < info->x + info->width  ? window->x + window->width  : info->x + info->width;
+			int32_t bottom = window->y + window->height < info->y + info->height ? window->y + window->height : info->y + info->height;
+			if (right > left && bottom > top) {
+				overlap = (int64_t)(right - left) * (int64_t)(bottom - top);
+			}
+		}
+		if (overlap > best || (overlap == best && info->is_primary)) {
+			best = overlap;
+			rate = info->refresh_rate;
+		}
+	}
+	ska_linux_monitor_unlock();
+
+	return rate;
 }
 
 void ska_platform_warp_mouse(ska_window_t* ref_window, int32_t x, int32_t y) {
 	ref_window->mouse_warped = true;
 	XWarpPointer(g_ska.x_display, None, ref_window->xwindow, 0, 0, 0, 0, x, y);
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 }
 
 // Cursor cache and state (shared between ska_platform_set_cursor and ska_platform_show_cursor)
@@ -554,21 +1043,17 @@ void ska_platform_set_cursor(ska_system_cursor_ cursor) {
 	g_current_cursor = cursor;
 
 	// Apply to all windows
-	for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-		if (g_ska.windows[i]) {
-			XDefineCursor(g_ska.x_display, g_ska.windows[i]->xwindow, g_x_cursors[cursor]);
-		}
+	for (uint32_t i = 0; i < g_ska.window_count; i++) {
+		XDefineCursor(g_ska.x_display, g_ska.windows[i]->xwindow, g_x_cursors[cursor]);
 	}
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 }
 
 void ska_platform_show_cursor(bool show) {
 	if (show) {
 		// Restore the current cursor (don't use XUndefineCursor which resets to parent's cursor)
-		for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-			if (g_ska.windows[i]) {
-				XDefineCursor(g_ska.x_display, g_ska.windows[i]->xwindow, g_x_cursors[g_current_cursor]);
-			}
+		for (uint32_t i = 0; i < g_ska.window_count; i++) {
+			XDefineCursor(g_ska.x_display, g_ska.windows[i]->xwindow, g_x_cursors[g_current_cursor]);
 		}
 	} else {
 		// Create invisible cursor
@@ -581,13 +1066,11 @@ void ska_platform_show_cursor(bool show) {
 			XFreePixmap(g_ska.x_display, blank);
 		}
 
-		for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-			if (g_ska.windows[i]) {
-				XDefineCursor(g_ska.x_display, g_ska.windows[i]->xwindow, invisible_cursor);
-			}
+		for (uint32_t i = 0; i < g_ska.window_count; i++) {
+			XDefineCursor(g_ska.x_display, g_ska.windows[i]->xwindow, invisible_cursor);
 		}
 	}
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 }
 
 bool ska_platform_set_relative_mouse_mode(bool enabled) {
@@ -596,360 +1079,886 @@ bool ska_platform_set_relative_mouse_mode(bool enabled) {
 	return true;
 }
 
-void ska_platform_pump_events(void) {
-	while (XPending(g_ska.x_display)) {
-		XEvent xev;
-		XNextEvent(g_ska.x_display, &xev);
+// ========== Event Timestamps ==========
+//
+// X events carry the server's millisecond clock. We map it onto ours by
+// tracking offset = local - server: each sample is an upper bound on the
+// true offset (delivery latency is never negative), so the estimate follows
+// new minimums immediately and only creeps upward at a drift-sized rate.
+
+#define SKA_X11_TIME_DRIFT_PPM  100           // Upward creep allowed for the offset estimate
+#define SKA_X11_TIME_RESYNC_NS  1000000000LL  // Samples this far off mean the server clock jumped
+
+static bool ska_linux_event_server_time(const XEvent* xev, Time* out_time) {
+	switch (xev->type) {
+	case KeyPress:
+	case KeyRelease:    *out_time = xev->xkey.time;      break;
+	case ButtonPress:
+	case ButtonRelease: *out_time = xev->xbutton.time;   break;
+	case MotionNotify:  *out_time = xev->xmotion.time;   break;
+	case EnterNotify:
+	case LeaveNotify:   *out_time = xev->xcrossing.time; break;
+	case PropertyNotify:*out_time = xev->xproperty.time; break;
+	default: return false;
+	}
+	// Synthetic events from other clients may not carry a real time
+	return *out_time != CurrentTime;
+}
 
-		// Filter through input method first
-		if (XFilterEvent(&xev, None)) {
-			continue;
+// Event time on the ska_time_get_elapsed_ns() clock. Never in the future and
+// never earlier than the previous event, so queue order and time order agree.
+static uint64_t ska_linux_event_time_ns(const XEvent* xev) {
+	uint64_t now_ns = ska_time_get_elapsed_ns();
+	uint64_t result = now_ns;
+
+	Time server_time;
+	if (ska_linux_event_server_time(xev, &server_time)) {
+		// Server time is 32 bits of milliseconds, unwrap it
+		uint32_t server_ms = (uint32_t)server_time;
+		if (g_ska.x_time_synced) {
+			g_ska.x_time_server_ms += (int32_t)(server_ms - g_ska.x_time_last);
+		} else {
+			g_ska.x_time_server_ms = server_ms;
+		}
+		g_ska.x_time_last = server_ms;
+
+		int64_t server_ns = g_ska.x_time_server_ms * 1000000LL;
+		int64_t sample    = (int64_t)now_ns - server_ns;
+		int64_t error     = sample - g_ska.x_time_offset_ns;
+		if (!g_ska.x_time_synced || error > SKA_X11_TIME_RESYNC_NS || error < -SKA_X11_TIME_RESYNC_NS) {
+			g_ska.x_time_offset_ns = sample;
+			g_ska.x_time_synced    = true;
+		} else if (error < 0) {
+			g_ska.x_time_offset_ns = sample;
+		} else {
+			int64_t creep = (int64_t)(now_ns - g_ska.x_time_sample_ns) / (1000000 / SKA_X11_TIME_DRIFT_PPM);
+			g_ska.x_time_offset_ns += creep < error ? creep : error;
 		}
+		g_ska.x_time_sample_ns = now_ns;
 
-		// Handle root window events (DPI change detection)
-		if (xev.xany.window == g_ska.x_root) {
-			if (xev.type == PropertyNotify && xev.xproperty.atom == g_ska.resource_manager) {
-				// RESOURCE_MANAGER changed - check if DPI scale changed
-				float new_scale = ska_platform_get_dpi_scale(NULL);
-				if (new_scale != g_ska.cached_dpi_scale && g_ska.cached_dpi_scale > 0.0f) {
-					g_ska.cached_dpi_scale = new_scale;
-
-					// Send DPI changed event to all windows
-					for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-						ska_window_t* win = g_ska.windows[i];
-						if (win) {
-							win->dpi_scale = new_scale;
-
-							ska_event_t event = {0};
-							event.timestamp          = (uint32_t)ska_time_get_elapsed_ms();
-							event.type               = ska_event_window_dpi_changed;
-							event.window.window_id   = win->id;
-							event.window.data1       = (int32_t)(new_scale * 100.0f + 0.5f);
-							ska_post_event(&event);
-						}
-					}
-				}
-			}
-			continue;
+		int64_t local_ns = server_ns + g_ska.x_time_offset_ns;
+		result = local_ns < 0 ? 0 : (uint64_t)local_ns;
+		if (result > now_ns) result = now_ns;
+	}
+
+	if (result < g_ska.x_time_last_ns) result = g_ska.x_time_last_ns;
+	g_ska.x_time_last_ns = result;
+	return result;
+}
+
+// Updates the keyboard state for a key event and returns its scancode
+static ska_scancode_ ska_linux_track_key(XKeyEvent* key, bool pressed) {
+	// Convert keycode to KeySym for layout-independent mapping
+	KeySym keysym = XLookupKeysym(key, 0);
+	ska_scancode_ scancode = ska_keysym_to_scancode(keysym);
+
+	if (scancode != ska_scancode_unknown) {
+		// Cache the scancode in the table for faster lookups
+		ska_x11_scancode_table[key->keycode] = scancode;
+
+		// Update keyboard state FIRST (before deriving modifiers)
+		g_ska.input_state.keyboard[scancode] = pressed ? 1 : 0;
+	}
+
+	// Derive modifier state from tracked keyboard state (post-event).
+	// This matches Win32's GetKeyState() behavior and avoids X11's quirk
+	// where xkey.state contains pre-event modifier state.
+	uint16_t mods = 0;
+	if (g_ska.input_state.keyboard[ska_scancode_lshift] || g_ska.input_state.keyboard[ska_scancode_rshift]) mods |= ska_keymod_shift;
+	if (g_ska.input_state.keyboard[ska_scancode_lctrl]  || g_ska.input_state.keyboard[ska_scancode_rctrl])  mods |= ska_keymod_ctrl;
+	if (g_ska.input_state.keyboard[ska_scancode_lalt]   || g_ska.input_state.keyboard[ska_scancode_ralt])   mods |= ska_keymod_alt;
+	if (g_ska.input_state.keyboard[ska_scancode_lgui]   || g_ska.input_state.keyboard[ska_scancode_rgui])   mods |= ska_keymod_gui;
+	g_ska.input_state.key_modifiers = mods;
+
+	return scancode;
+}
+
+// Updates the mouse button state for a (non-wheel) button event and returns
+// the sk_app button
+static ska_mouse_button_ ska_linux_track_button(unsigned int x_button, bool pressed) {
+	// Map X11 button numbers to ska_mouse_button_ values
+	// X11: 1-3 = left/middle/right, 8-9 = back/forward (side buttons)
+	// ska: 1-3 = left/middle/right, 4-5 = x1/x2 (side buttons)
+	ska_mouse_button_ button;
+	switch (x_button) {
+		case Button1: button = ska_mouse_button_left;   break;
+		case Button2: button = ska_mouse_button_middle; break;
+		case Button3: button = ska_mouse_button_right;  break;
+		case 8:       button = ska_mouse_button_x1;     break; // Back
+		case 9:       button = ska_mouse_button_x2;     break; // Forward
+		default:      button = x_button;                break;
+	}
+
+	uint32_t button_mask = (1 << (button - 1));
+	if (pressed) {
+		g_ska.input_state.mouse_buttons |= button_mask;
+	} else {
+		g_ska.input_state.mouse_buttons &= ~button_mask;
+	}
+	return button;
+}
+
+// Moves the tracked pointer. Motion that never becomes an event goes through
+// here too, so the next motion event's xrel/yrel measure from where the
+// pointer really is rather than from where it was last reported.
+static void ska_linux_track_pointer(int32_t x, int32_t y) {
+	g_ska.input_state.mouse_xrel = x - g_ska.input_state.mouse_x;
+	g_ska.input_state.mouse_yrel = y - g_ska.input_state.mouse_y;
+	g_ska.input_state.mouse_x    = x;
+	g_ska.input_state.mouse_y    = y;
+}
+
+// Input of a disabled type never gets translated. It skips the window lookup,
+// time correlation and event building, and only updates the keyboard and
+// mouse state the query functions report. Returns true if it handled xev.
+static bool ska_linux_track_disabled_input(XEvent* xev) {
+	switch (xev->type) {
+	case KeyPress:
+	case KeyRelease: {
+		bool pressed = xev->type == KeyPress;
+		if (ska_event_type_enabled(pressed ? ska_event_key_down : ska_event_key_up) ||
+		    (pressed && ska_event_type_enabled(ska_event_text_input))) {
+			return false;
 		}
+		ska_linux_track_key(&xev->xkey, pressed);
+		return true;
+	}
 
-		ska_window_t* window = ska_find_window_by_xwindow(xev.xany.window);
-		if (!window) {
-			continue;
+	case ButtonPress:
+	case ButtonRelease: {
+		bool pressed = xev->type == ButtonPress;
+		if (xev->xbutton.button >= Button4 && xev->xbutton.button <= 7) {
+			// Wheel clicks carry no state, only the press becomes an event
+			return !pressed || !ska_event_type_enabled(ska_event_mouse_wheel);
 		}
+		if (ska_event_type_enabled(pressed ? ska_event_mouse_button_down : ska_event_mouse_button_up)) {
+			return false;
+		}
+		ska_linux_track_button(xev->xbutton.button, pressed);
+		return true;
+	}
 
-		ska_event_t event = {0};
-		event.timestamp = (uint32_t)ska_time_get_elapsed_ms();
-
-		switch (xev.type) {
-		case KeyPress:
-		case KeyRelease: {
-			event.type = (xev.type == KeyPress) ? ska_event_key_down : ska_event_key_up;
-			event.keyboard.window_id = window->id;
-			event.keyboard.pressed = (xev.type == KeyPress);
-			event.keyboard.repeat = false; // X11 sends release+press for repeats
-
-			// Convert keycode to KeySym for layout-independent mapping
-			KeySym keysym = XLookupKeysym(&xev.xkey, 0);
-			event.keyboard.scancode = ska_keysym_to_scancode(keysym);
-
-			// Cache the scancode in the table for faster lookups
-			if (event.keyboard.scancode != ska_scancode_unknown) {
-				ska_x11_scancode_table[xev.xkey.keycode] = event.keyboard.scancode;
-			}
+	case MotionNotify:
+		if (ska_event_type_enabled(ska_event_mouse_motion)) {
+			return false;
+		}
+		ska_linux_track_pointer(xev->xmotion.x, xev->xmotion.y);
+		return true;
 
-			// Update keyboard state FIRST (before deriving modifiers)
-			if (event.keyboard.scancode != ska_scancode_unknown) {
-				g_ska.input_state.keyboard[event.keyboard.scancode] = event.keyboard.pressed ? 1 : 0;
-			}
+	default:
+		return false;
+	}
+}
 
-			// Derive modifier state from tracked keyboard state (post-event).
-			// This matches Win32's GetKeyState() behavior and avoids X11's quirk
-			// where xkey.state contains pre-event modifier state.
-			uint16_t mods = 0;
-			if (g_ska.input_state.keyboard[ska_scancode_lshift] || g_ska.input_state.keyboard[ska_scancode_rshift]) mods |= ska_keymod_shift;
-			if (g_ska.input_state.keyboard[ska_scancode_lctrl]  || g_ska.input_state.keyboard[ska_scancode_rctrl])  mods |= ska_keymod_ctrl;
-			if (g_ska.input_state.keyboard[ska_scancode_lalt]   || g_ska.input_state.keyboard[ska_scancode_ralt])   mods |= ska_keymod_alt;
-			if (g_ska.input_state.keyboard[ska_scancode_lgui]   || g_ska.input_state.keyboard[ska_scancode_rgui])   mods |= ska_keymod_gui;
-			event.keyboard.modifiers = mods;
-			g_ska.input_state.key_modifiers = mods;
+// Posts a window event that carries no data, unless its type is disabled
+static void ska_linux_post_window_event(ska_event_t* ref_event, ska_event_ type, const ska_window_t* window) {
+	if (!ska_event_type_enabled(type)) {
+		return;
+	}
+	ref_event->type             = type;
+	ref_event->window.window_id = window->id;
+	ska_post_event(ref_event);
+}
 
-			ska_post_event(&event);
+// Reparenting into a frame moves us on the root without a ConfigureNotify we
+// can use, and the synthetic one only comes with the next move, so ask
+static void ska_linux_refresh_position(ska_window_t* ref_window) {
+	ref_window->position_dirty = false;
 
-			// Handle text input
-			if (xev.type == KeyPress && window->xic) {
-				char buffer[32];
-				KeySym keysym_text;
-				Status status;
-				int32_t len = Xutf8LookupString(window->xic, &xev.xkey, buffer, sizeof(buffer) - 1, &keysym_text, &status);
-				if (len > 0 && (status == XLookupChars || status == XLookupBoth)) {
-					buffer[len] = '\0';
-					event.type = ska_event_text_input;
-					event.text.window_id = window->id;
-					strncpy(event.text.text, buffer, sizeof(event.text.text) - 1);
-					ska_post_event(&event);
-				}
-			}
-			break;
-		}			case ButtonPress:
-			case ButtonRelease: {
-				if (xev.xbutton.button >= Button4 && xev.xbutton.button <= 7) {
-					// Mouse wheel (vertical: Button4/Button5, horizontal: Button6/Button7)
-					if (xev.type == ButtonPress) {
-						event.type = ska_event_mouse_wheel;
-						event.mouse_wheel.window_id = window->id;
-
-						if (xev.xbutton.button == Button4 || xev.xbutton.button == Button5) {
-							// Vertical scroll
-							event.mouse_wheel.x = 0;
-							event.mouse_wheel.y = (xev.xbutton.button == Button4) ? 1 : -1;
-							event.mouse_wheel.precise_x = 0.0f;
-							event.mouse_wheel.precise_y = (float)event.mouse_wheel.y;
-						} else {
-							// Horizontal scroll (Button6 = left, Button7 = right)
-							event.mouse_wheel.x = (xev.xbutton.button == 6) ? -1 : 1;
-							event.mouse_wheel.y = 0;
-							event.mouse_wheel.precise_x = (float)event.mouse_wheel.x;
-							event.mouse_wheel.precise_y = 0.0f;
-						}
-						ska_post_event(&event);
-					}
-				} else {
-					// Mouse button
-					event.type = (xev.type == ButtonPress) ? ska_event_mouse_button_down : ska_event_mouse_button_up;
-					event.mouse_button.window_id = window->id;
-
-					// Map X11 button numbers to ska_mouse_button_ values
-					// X11: 1-3 = left/middle/right, 8-9 = back/forward (side buttons)
-					// ska: 1-3 = left/middle/right, 4-5 = x1/x2 (side buttons)
-					ska_mouse_button_ button;
-					switch (xev.xbutton.button) {
-						case Button1: button = ska_mouse_button_left;   break;
-						case Button2: button = ska_mouse_button_middle; break;
-						case Button3: button = ska_mouse_button_right;  break;
-						case 8:       button = ska_mouse_button_x1;     break; // Back
-						case 9:       button = ska_mouse_button_x2;     break; // Forward
-						default:      button = xev.xbutton.button;      break;
-					}
-					event.mouse_button.button = button;
-					event.mouse_button.pressed = (xev.type == ButtonPress);
-					event.mouse_button.clicks = 1;
-					event.mouse_button.x = xev.xbutton.x;
-					event.mouse_button.y = xev.xbutton.y;
-
-					// Update button state
-					uint32_t button_mask = (1 << (button - 1));
-					if (event.mouse_button.pressed) {
-						g_ska.input_state.mouse_buttons |= button_mask;
-					} else {
-						g_ska.input_state.mouse_buttons &= ~button_mask;
-					}
+	int    root_x, root_y;
+	Window child;
+	SKA_X_ROUND_TRIP("XTranslateCoordinates");
+	if (!XTranslateCoordinates(g_ska.x_display, ref_window->xwindow, g_ska.x_root, 0, 0, &root_x, &root_y, &child)) {
+		return;
+	}
+	if (root_x != ref_window->x || root_y != ref_window->y) {
+		ref_window->x = root_x;
+		ref_window->y = root_y;
+		if (ska_event_type_enabled(ska_event_window_moved)) {
+			ref_window->move_pending      = true;
+			ref_window->configure_time_ns = ska_time_get_elapsed_ns();
+		}
+	}
+}
+
+// Posts the resized and moved events a window has pending
+static void ska_linux_post_configure(ska_window_t* ref_window) {
+	if (ref_window->position_dirty) {
+		ska_linux_refresh_position(ref_window);
+	}
+	if (!(ref_window->resize_pending || ref_window->move_pending)) {
+		return;
+	}
 
+	ska_event_t event = {0};
+	event.timestamp_ns     = ref_window->configure_time_ns;
+	event.window.window_id = ref_window->id;
+	if (ref_window->resize_pending) {
+		event.type         = ska_event_window_resized;
+		event.window.data1 = ref_window->width;
+		event.window.data2 = ref_window->height;
+		ska_post_event(&event);
+	}
+	if (ref_window->move_pending) {
+		event.type         = ska_event_window_moved;
+		event.window.data1 = ref_window->x;
+		event.window.data2 = ref_window->y;
+		ska_post_event(&event);
+	}
+	ref_window->resize_pending = false;
+	ref_window->move_pending   = false;
+}
+
+// Translates one X event into sk_app events, on whichever thread reads the connection
+static void ska_linux_translate_event(XEvent* xev) {
+	// Filter through input method first
+	if (XFilterEvent(xev, None)) {
+		return;
+	}
+
+	if (ska_linux_track_disabled_input(xev)) {
+		return;
+	}
+
+	// RandR output, CRTC or screen changes; XRRUpdateConfiguration keeps
+	// Xlib's idea of the screen size current
+	if (g_ska.x_rr_available && (xev->type == g_ska.x_rr_event_base + RRScreenChangeNotify ||
+	                             xev->type == g_ska.x_rr_event_base + RRNotify)) {
+		XRRUpdateConfiguration(xev);
+		g_ska.x_monitors_dirty = true;
+		return;
+	}
+
+	// Handle root window events (DPI and work area changes)
+	if (xev->xany.window == g_ska.x_root) {
+		if (xev->type == PropertyNotify && xev->xproperty.atom == g_ska.x_atoms[ska_x_atom_net_workarea]) {
+			g_ska.x_monitors_dirty = true;
+		}
+		if (xev->type == PropertyNotify && xev->xproperty.atom == g_ska.x_atoms[ska_x_atom_resource_manager]) {
+			// RESOURCE_MANAGER changed - check if DPI scale changed
+			float new_scale = ska_linux_reload_dpi_scale();
+			if (new_scale != g_ska.cached_dpi_scale) {
+				g_ska.cached_dpi_scale = new_scale;
+				g_ska.x_monitors_dirty = true; // Monitors carry the scale too
+				uint64_t timestamp_ns = ska_linux_event_time_ns(xev);
+
+				// Send DPI changed event to all windows
+				for (uint32_t i = 0; i < g_ska.window_count; i++) {
+					ska_window_t* win = g_ska.windows[i];
+					win->dpi_scale = new_scale;
+
+					ska_event_t event = {0};
+					event.timestamp_ns       = timestamp_ns;
+					event.type               = ska_event_window_dpi_changed;
+					event.window.window_id   = win->id;
+					event.window.data1       = (int32_t)(new_scale * 100.0f + 0.5f);
 					ska_post_event(&event);
 				}
-				break;
 			}
+		}
+		return;
+	}
 
-			case MotionNotify: {
-				if (window->mouse_warped) {
-					window->mouse_warped = false;
-					break;
-				}
+	ska_window_t* window = ska_find_window_by_xwindow(xev->xany.window);
+	if (!window) {
+		return;
+	}
 
-				event.type = ska_event_mouse_motion;
-				event.mouse_motion.window_id = window->id;
-				event.mouse_motion.x = xev.xmotion.x;
-				event.mouse_motion.y = xev.xmotion.y;
-				event.mouse_motion.xrel = xev.xmotion.x - g_ska.input_state.mouse_x;
-				event.mouse_motion.yrel = xev.xmotion.y - g_ska.input_state.mouse_y;
+	// The app hit-tests input against the geometry it has been told about,
+	// so pending changes for this window go out ahead of the input
+	switch (xev->type) {
+	case KeyPress:
+	case KeyRelease:
+	case ButtonPress:
+	case ButtonRelease:
+	case MotionNotify:
+	case EnterNotify:
+	case LeaveNotify:
+		ska_linux_post_configure(window);
+		break;
+	default:
+		break;
+	}
 
-				g_ska.input_state.mouse_x = xev.xmotion.x;
-				g_ska.input_state.mouse_y = xev.xmotion.y;
-				g_ska.input_state.mouse_xrel = event.mouse_motion.xrel;
-				g_ska.input_state.mouse_yrel = event.mouse_motion.yrel;
+	ska_event_t event = {0};
+	event.timestamp_ns = ska_linux_event_time_ns(xev);
+
+	switch (xev->type) {
+	case KeyPress:
+	case KeyRelease: {
+		event.type = (xev->type == KeyPress) ? ska_event_key_down : ska_event_key_up;
+		event.keyboard.window_id = window->id;
+		event.keyboard.pressed = (xev->type == KeyPress);
+		event.keyboard.repeat = false; // X11 sends release+press for repeats
+		event.keyboard.scancode = ska_linux_track_key(&xev->xkey, event.keyboard.pressed);
+		event.keyboard.modifiers = g_ska.input_state.key_modifiers;
+
+		// Here for the text alone when key events are disabled
+		if (ska_event_type_enabled(event.type)) {
+			ska_post_event(&event);
+		}
 
+		// Handle text input
+		if (xev->type == KeyPress && window->xic && ska_event_type_enabled(ska_event_text_input)) {
+			char buffer[32];
+			KeySym keysym_text;
+			Status status;
+			int32_t len = Xutf8LookupString(window->xic, &xev->xkey, buffer, sizeof(buffer) - 1, &keysym_text, &status);
+			if (len > 0 && (status == XLookupChars || status == XLookupBoth)) {
+				buffer[len] = '\0';
+				event.type = ska_event_text_input;
+				event.text.window_id = window->id;
+				strncpy(event.text.text, buffer, sizeof(event.text.text) - 1);
 				ska_post_event(&event);
-				break;
 			}
+		}
+		break;
+	}
 
-			case EnterNotify:
-				event.type = ska_event_window_mouse_enter;
-				event.window.window_id = window->id;
-				window->mouse_inside = true;
+	case ButtonPress:
+	case ButtonRelease: {
+		if (xev->xbutton.button >= Button4 && xev->xbutton.button <= 7) {
+			// Mouse wheel (vertical: Button4/Button5, horizontal: Button6/Button7)
+			if (xev->type == ButtonPress) {
+				event.type = ska_event_mouse_wheel;
+				event.mouse_wheel.window_id = window->id;
+
+				if (xev->xbutton.button == Button4 || xev->xbutton.button == Button5) {
+					// Vertical scroll
+					event.mouse_wheel.x = 0;
+					event.mouse_wheel.y = (xev->xbutton.button == Button4) ? 1 : -1;
+					event.mouse_wheel.precise_x = 0.0f;
+					event.mouse_wheel.precise_y = (float)event.mouse_wheel.y;
+				} else {
+					// Horizontal scroll (Button6 = left, Button7 = right)
+					event.mouse_wheel.x = (xev->xbutton.button == 6) ? -1 : 1;
+					event.mouse_wheel.y = 0;
+					event.mouse_wheel.precise_x = (float)event.mouse_wheel.x;
+					event.mouse_wheel.precise_y = 0.0f;
+				}
 				ska_post_event(&event);
-				break;
+			}
+		} else {
+			// Mouse button
+			event.type = (xev->type == ButtonPress) ? ska_event_mouse_button_down : ska_event_mouse_button_up;
+			event.mouse_button.window_id = window->id;
+			event.mouse_button.pressed = (xev->type == ButtonPress);
+			event.mouse_button.button = ska_linux_track_button(xev->xbutton.button, event.mouse_button.pressed);
+			event.mouse_button.clicks = 1;
+			event.mouse_button.x = xev->xbutton.x;
+			event.mouse_button.y = xev->xbutton.y;
 
-			case LeaveNotify:
-				event.type = ska_event_window_mouse_leave;
-				event.window.window_id = window->id;
-				window->mouse_inside = false;
-				ska_post_event(&event);
-				break;
+			ska_post_event(&event);
+		}
+		break;
+	}
 
-			case FocusIn:
-				event.type = ska_event_window_focus_gained;
-				event.window.window_id = window->id;
-				window->has_focus = true;
-				if (window->xic) {
-					XSetICFocus(window->xic);
-				}
-				ska_post_event(&event);
-				break;
+	case MotionNotify: {
+		ska_linux_track_pointer(xev->xmotion.x, xev->xmotion.y);
 
-			case FocusOut:
-				event.type = ska_event_window_focus_lost;
-				event.window.window_id = window->id;
-				window->has_focus = false;
-				if (window->xic) {
-					XUnsetICFocus(window->xic);
-				}
-				ska_post_event(&event);
-				break;
+		// Our own warp moved the pointer, the user didn't
+		if (window->mouse_warped) {
+			window->mouse_warped = false;
+			break;
+		}
 
-			case ConfigureNotify:
-				if (xev.xconfigure.width != window->width || xev.xconfigure.height != window->height) {
-					event.type = ska_event_window_resized;
-					event.window.window_id = window->id;
-					event.window.data1 = xev.xconfigure.width;
-					event.window.data2 = xev.xconfigure.height;
-					window->width = xev.xconfigure.width;
-					window->height = xev.xconfigure.height;
-					window->drawable_width = xev.xconfigure.width;
-					window->drawable_height = xev.xconfigure.height;
-					ska_post_event(&event);
-				}
-				{
-					// ConfigureNotify gives position relative to parent (WM frame).
-					// Translate to root coordinates for actual screen position.
-					Window child;
-					int32_t root_x, root_y;
-					XTranslateCoordinates(g_ska.x_display, window->xwindow, g_ska.x_root, 0, 0, &root_x, &root_y, &child);
-
-					if (root_x != window->x || root_y != window->y) {
-						event.type = ska_event_window_moved;
-						event.window.window_id = window->id;
-						event.window.data1 = root_x;
-						event.window.data2 = root_y;
-						window->x = root_x;
-						window->y = root_y;
-						ska_post_event(&event);
-					}
-				}
-				break;
+		event.type = ska_event_mouse_motion;
+		event.mouse_motion.window_id = window->id;
+		event.mouse_motion.x = xev->xmotion.x;
+		event.mouse_motion.y = xev->xmotion.y;
+		event.mouse_motion.xrel = g_ska.input_state.mouse_xrel;
+		event.mouse_motion.yrel = g_ska.input_state.mouse_yrel;
 
-			case MapNotify:
-				if (!window->is_visible) {
-					event.type = ska_event_window_shown;
-					event.window.window_id = window->id;
-					window->is_visible = true;
-					ska_post_event(&event);
-				}
-				break;
+		ska_post_event(&event);
+		break;
+	}
 
-			case UnmapNotify:
-				if (window->is_visible) {
-					event.type = ska_event_window_hidden;
-					event.window.window_id = window->id;
-					window->is_visible = false;
-					ska_post_event(&event);
-				}
-				break;
+	case EnterNotify:
+		window->mouse_inside = true;
+		ska_linux_post_window_event(&event, ska_event_window_mouse_enter, window);
+		break;
 
-			case ClientMessage:
-				if (xev.xclient.message_type == g_ska.wm_protocols &&
-					(Atom)xev.xclient.data.l[0] == g_ska.wm_delete_window) {
-					event.type = ska_event_window_close;
-					event.window.window_id = window->id;
-					window->should_close = true;
-					ska_post_event(&event);
-				}
-				break;
+	case LeaveNotify:
+		window->mouse_inside = false;
+		ska_linux_post_window_event(&event, ska_event_window_mouse_leave, window);
+		break;
 
-			case SelectionRequest: {
-				// Handle clipboard data requests from other applications
-				XSelectionRequestEvent* req = &xev.xselectionrequest;
+	case FocusIn:
+		window->has_focus = true;
+		if (window->xic) {
+			XSetICFocus(window->xic);
+		}
+		ska_linux_post_window_event(&event, ska_event_window_focus_gained, window);
+		break;
 
-				// If property is None, use the target as the property (some apps do this)
-				Atom property = req->property;
-				if (property == None) {
-					property = req->target;
+	case FocusOut:
+		window->has_focus = false;
+		if (window->xic) {
+			XUnsetICFocus(window->xic);
+		}
+		ska_linux_post_window_event(&event, ska_event_window_focus_lost, window);
+		break;
+
+	case ConfigureNotify: {
+		// Only recorded here, ska_linux_post_pending() (or the window's next
+		// input) turns everything a drag or resize queued up into one resized
+		// and one moved event.
+		// The geometry getters read it too, so disabled types only skip
+		// the pending event.
+		XConfigureEvent* configure = &xev->xconfigure;
+		bool             resized   = ska_event_type_enabled(ska_event_window_resized);
+		bool             moved     = ska_event_type_enabled(ska_event_window_moved);
+		if (configure->width != window->width || configure->height != window->height) {
+			window->width = configure->width;
+			window->height = configure->height;
+			window->drawable_width = configure->width;
+			window->drawable_height = configure->height;
+			if (resized) {
+				window->resize_pending = true;
+				window->configure_time_ns = event.timestamp_ns;
+			}
+		}
+
+		// Real events are relative to our parent, which is only the root
+		// when no window manager reparented us. Reparenting ones follow
+		// every move with a synthetic event in root coordinates (ICCCM
+		// 4.1.5), so the rest can be skipped instead of asking the server.
+		if (configure->send_event || window->parent == g_ska.x_root) {
+			int32_t root_x = configure->x + configure->border_width;
+			int32_t root_y = configure->y + configure->border_width;
+			window->position_dirty = false;
+			if (root_x != window->x || root_y != window->y) {
+				window->x = root_x;
+				window->y = root_y;
+				if (moved) {
+					window->move_pending = true;
+					window->configure_time_ns = event.timestamp_ns;
 				}
+			}
+		}
+		break;
+	}
 
-				XEvent response;
-				memset(&response, 0, sizeof(response));
-				response.xselection.type = SelectionNotify;
-				response.xselection.requestor = req->requestor;
-				response.xselection.selection = req->selection;
-				response.xselection.target = req->target;
-				response.xselection.time = req->time;
-				response.xselection.property = None;
-
-				Atom clipboard_atom = XInternAtom(g_ska.x_display, "CLIPBOARD", False);
-				Atom utf8_atom = XInternAtom(g_ska.x_display, "UTF8_STRING", False);
-				Atom text_atom = XInternAtom(g_ska.x_display, "TEXT", False);
-				Atom string_atom = XA_STRING;
-				Atom targets_atom = XInternAtom(g_ska.x_display, "TARGETS", False);
-				Atom text_plain_atom = XInternAtom(g_ska.x_display, "text/plain", False);
-				Atom text_plain_utf8_atom = XInternAtom(g_ska.x_display, "text/plain;charset=utf-8", False);
-				Atom property_atom = XInternAtom(g_ska.x_display, "SKA_CLIPBOARD_DATA", False);
-
-				if (req->selection == clipboard_atom) {
-					// Handle TARGETS request - tell requestor what formats we support
-					if (req->target == targets_atom) {
-						Atom supported_targets[] = {
-							targets_atom,
-							utf8_atom,
-							text_atom,
-							string_atom,
-							text_plain_atom,
-							text_plain_utf8_atom
-						};
-						XChangeProperty(
-							g_ska.x_display, req->requestor, property,
-							XA_ATOM, 32, PropModeReplace,
-							(unsigned char*)supported_targets, 6
-						);
-						response.xselection.property = property;
-					}
-					// Handle UTF8_STRING, TEXT, STRING, or MIME type requests
-					else if (req->target == utf8_atom || req->target == text_atom || req->target == string_atom ||
-					         req->target == text_plain_atom || req->target == text_plain_utf8_atom) {
-						// Check if we have clipboard data stored
-						Atom actual_type;
-						int32_t actual_format;
-						unsigned long nitems, bytes_after;
-						unsigned char* data = NULL;
-
-						int32_t result = XGetWindowProperty(
-							g_ska.x_display, window->xwindow, property_atom,
-							0, 0x1FFFFFFF, False, AnyPropertyType,
-							&actual_type, &actual_format, &nitems, &bytes_after, &data
-						);
-
-						if (result == Success && data && nitems > 0) {
-							// We have data - send it to the requestor
-							XChangeProperty(
-								g_ska.x_display, req->requestor, property,
-								req->target, 8, PropModeReplace,
-								data, nitems
-							);
-							response.xselection.property = property;
-							XFree(data);
-						}
-					}
+	case ReparentNotify:
+		window->parent = xev->xreparent.parent;
+		if (window->parent != g_ska.x_root) {
+			// Framed, the event only has our offset in the frame
+			window->position_dirty = true;
+		} else {
+			window->position_dirty = false;
+			if (xev->xreparent.x != window->x || xev->xreparent.y != window->y) {
+				// Unframed again, the event carries our root position
+				window->x = xev->xreparent.x;
+				window->y = xev->xreparent.y;
+				if (ska_event_type_enabled(ska_event_window_moved)) {
+					window->move_pending = true;
+					window->configure_time_ns = event.timestamp_ns;
 				}
+			}
+		}
+		break;
 
-				XSendEvent(g_ska.x_display, req->requestor, False, 0, &response);
-				XFlush(g_ska.x_display);
-				break;
+	case PropertyNotify:
+		if (xev->xproperty.atom == g_ska.x_atoms[ska_x_atom_net_frame_extents]) {
+			if (xev->xproperty.state == PropertyDelete) {
+				memset(window->frame_extents, 0, sizeof(window->frame_extents));
+			} else {
+				ska_linux_update_frame_extents(window);
+			}
+		}
+		break;
+
+	case MapNotify:
+		if (!window->is_visible) {
+			window->is_visible = true;
+			ska_linux_post_window_event(&event, ska_event_window_shown, window);
+		}
+		break;
+
+	case UnmapNotify:
+		if (window->is_visible) {
+			window->is_visible = false;
+			ska_linux_post_window_event(&event, ska_event_window_hidden, window);
+		}
+		break;
+
+	case ClientMessage:
+		if (xev->xclient.message_type == g_ska.x_atoms[ska_x_atom_wm_protocols] &&
+			(Atom)xev->xclient.data.l[0] == g_ska.x_atoms[ska_x_atom_wm_delete_window]) {
+			window->should_close = true;
+			ska_linux_post_window_event(&event, ska_event_window_close, window);
+		}
+		break;
+
+	case SelectionRequest: {
+		// Handle clipboard data requests from other applications
+		XSelectionRequestEvent* req = &xev->xselectionrequest;
+
+		// If property is None, use the target as the property (some apps do this)
+		Atom property = req->property;
+		if (property == None) {
+			property = req->target;
+		}
+
+		XEvent response;
+		memset(&response, 0, sizeof(response));
+		response.xselection.type = SelectionNotify;
+		response.xselection.requestor = req->requestor;
+		response.xselection.selection = req->selection;
+		response.xselection.target = req->target;
+		response.xselection.time = req->time;
+		response.xselection.property = None;
+
+		Atom clipboard_atom = g_ska.x_atoms[ska_x_atom_clipboard];
+		Atom utf8_atom = g_ska.x_atoms[ska_x_atom_utf8_string];
+		Atom text_atom = g_ska.x_atoms[ska_x_atom_text];
+		Atom string_atom = XA_STRING;
+		Atom targets_atom = g_ska.x_atoms[ska_x_atom_targets];
+		Atom text_plain_atom = g_ska.x_atoms[ska_x_atom_text_plain];
+		Atom text_plain_utf8_atom = g_ska.x_atoms[ska_x_atom_text_plain_utf8];
+
+		if (req->selection == clipboard_atom) {
+			// Handle TARGETS request - tell requestor what formats we support
+			if (req->target == targets_atom) {
+				Atom supported_targets[] = {
+					targets_atom,
+					utf8_atom,
+					text_atom,
+					string_atom,
+					text_plain_atom,
+					text_plain_utf8_atom
+				};
+				XChangeProperty(
+					g_ska.x_display, req->requestor, property,
+					XA_ATOM, 32, PropModeReplace,
+					(unsigned char*)supported_targets, 6
+				);
+				response.xselection.property = property;
 			}
+			// Handle UTF8_STRING, TEXT, STRING, or MIME type requests
+			else if (req->target == utf8_atom || req->target == text_atom || req->target == string_atom ||
+			         req->target == text_plain_atom || req->target == text_plain_utf8_atom) {
+				// Served from our own copy, see ska_platform_clipboard_set_text
+				if (g_ska.x_clipboard_text && g_ska.x_clipboard_owner == window->xwindow) {
+					XChangeProperty(
+						g_ska.x_display, req->requestor, property,
+						req->target, 8, PropModeReplace,
+						(const unsigned char*)g_ska.x_clipboard_text, (int)g_ska.x_clipboard_length
+					);
+					response.xselection.property = property;
+				}
+			}
+		}
+
+		XSendEvent(g_ska.x_display, req->requestor, False, 0, &response);
+		ska_linux_flush();
+		break;
+	}
+
+	case SelectionClear:
+		// Another client took the clipboard, our copy is stale
+		if (xev->xselectionclear.selection == g_ska.x_atoms[ska_x_atom_clipboard]) {
+			ska_linux_clipboard_release();
+		}
+		break;
+
+	case SelectionNotify:
+		// With the input thread running, the reply to our own XConvertSelection
+		// lands here instead of in ska_platform_clipboard_get_text's wait loop
+		if (g_ska.x_input_thread_running) {
+			g_ska.x_selection_event = xev->xselection;
+			atomic_store_explicit(&g_ska.x_selection_ready, true, memory_order_release);
+		}
+		break;
+	}
+}
+
+// Posts what translating a batch of events left pending: window geometry from
+// ConfigureNotify and display changes from ska_linux_monitors_update
+static void ska_linux_post_pending(void) {
+	bool display_changed = g_ska.x_monitors_changed;
+	g_ska.x_monitors_changed = false;
+	if (display_changed && ska_event_type_enabled(ska_event_display_changed)) {
+		ska_event_t event = {0};
+		event.type         = ska_event_display_changed;
+		event.window.data1 = ska_platform_display_count();
+		ska_post_event(&event);
+	}
+
+	for (uint32_t i = 0; i < g_ska.window_count; i++) {
+		ska_linux_post_configure(g_ska.windows[i]);
+	}
+}
+
+void ska_platform_pump_events(void) {
+	if (g_ska.x_input_thread_running) {
+		// The input thread reads the connection, but requests made from this
+		// thread still sit in Xlib's output buffer until someone flushes it
+		ska_linux_flush();
+
+		// Replies read by our own round trips can leave events in Xlib's queue
+		// without the socket becoming readable again, so nudge the input thread
+		if (XEventsQueued(g_ska.x_display, QueuedAlready) > 0) {
+			ska_linux_input_thread_wake();
 		}
+		return;
+	}
+
+	while (XPending(g_ska.x_display)) {
+		XEvent xev;
+		XNextEvent(g_ska.x_display, &xev);
+		ska_linux_translate_event(&xev);
 	}
+	ska_linux_monitors_update();
+	ska_linux_post_pending();
+	ska_linux_note_requests(); // XPending flushed whatever was buffered
 
 	// Check for file dialog completion
 	ska_linux_check_file_dialog();
 }
 
+// Defined with the file dialog code below
+static int ska_linux_file_dialog_fd(void);
+
+// Points x_timer_fd at the nearest timer deadline. Returns the fd to poll, or
+// -1 when no timer is pending.
+static int ska_linux_timer_arm(void) {
+	if (g_ska.x_timer_fd < 0) {
+		return -1;
+	}
+
+	uint64_t deadline_ns = ska_timer_next_deadline_ns();
+	if (deadline_ns != g_ska.x_timer_armed_ns) {
+		struct itimerspec spec = {0}; // All zero disarms
+		if (deadline_ns != UINT64_MAX) {
+			uint64_t clock_ns = g_ska.start_time + deadline_ns;
+			spec.it_value.tv_sec  = (time_t)(clock_ns / 1000000000ULL);
+			spec.it_value.tv_nsec = (long)  (clock_ns % 1000000000ULL);
+		}
+		timerfd_settime(g_ska.x_timer_fd, TFD_TIMER_ABSTIME, &spec, NULL);
+		g_ska.x_timer_armed_ns = deadline_ns;
+	}
+	return deadline_ns != UINT64_MAX ? g_ska.x_timer_fd : -1;
+}
+
+static void ska_linux_timer_drain(const struct pollfd* fd) {
+	if (fd->fd >= 0 && (fd->revents & POLLIN)) {
+		uint64_t expirations;
+		ssize_t  size = read(g_ska.x_timer_fd, &expirations, sizeof(expirations));
+		(void)size;
+		// Re-arm next time even if the app hasn't pumped the timer yet
+		g_ska.x_timer_armed_ns = 0;
+	}
+}
+
+void ska_platform_wait_events(int32_t timeout_ms) {
+	if (g_ska.x_input_thread_running) {
+		// The input thread owns the connection and pings us after each commit
+		struct pollfd fds[2] = {
+			{ g_ska.x_main_wake_pipe[0], POLLIN, 0 },
+			{ ska_linux_timer_arm(),     POLLIN, 0 }, // Negative fds are ignored
+		};
+		poll(fds, 2, timeout_ms < 0 ? -1 : timeout_ms);
+		ska_linux_pipe_drain(g_ska.x_main_wake_pipe[0]);
+		ska_linux_timer_drain(&fds[1]);
+
+		// Clear after draining: a commit racing with this either sees the flag
+		// still set (and the caller's re-poll finds its events) or writes again
+		atomic_store(&g_ska.x_main_wake_pending, false);
+		return;
+	}
+
+	// XPending flushes our output buffer and picks up anything already sitting
+	// on the socket, so only block when Xlib's queue is really empty.
+	if (XPending(g_ska.x_display)) {
+		return;
+	}
+
+	struct pollfd fds[4];
+	nfds_t        fd_count = 0;
+	fds[fd_count].fd     = ConnectionNumber(g_ska.x_display);
+	fds[fd_count].events = POLLIN;
+	fd_count++;
+
+	// Written by ska_platform_wake when another thread pushes an event
+	fds[fd_count].fd     = g_ska.x_main_wake_pipe[0];
+	fds[fd_count].events = POLLIN;
+	fd_count++;
+
+	// Fires on the next ska_timer_add() deadline
+	fds[fd_count].fd      = ska_linux_timer_arm();
+	fds[fd_count].events  = POLLIN;
+	fds[fd_count].revents = 0;
+	fd_count++;
+
+	// The file dialog pipe hits EOF when zenity/kdialog exits
+	int dialog_fd = ska_linux_file_dialog_fd();
+	if (dialog_fd >= 0) {
+		fds[fd_count].fd     = dialog_fd;
+		fds[fd_count].events = POLLIN;
+		fd_count++;
+	}
+
+	// EINTR and friends just return early, the caller re-polls
+	poll(fds, fd_count, timeout_ms < 0 ? -1 : timeout_ms);
+	if (fds[1].revents & POLLIN) {
+		ska_linux_pipe_drain(g_ska.x_main_wake_pipe[0]);
+		atomic_store(&g_ska.x_main_wake_pending, false);
+	}
+	ska_linux_timer_drain(&fds[2]);
+}
+
+// ========== Input Thread ==========
+//
+// Opt-in via ska_init_info_t.input_thread. The thread blocks on the X
+// connection, translates everything it reads and commits each batch to the
+// event queue right away, so event timestamps and queue order no longer depend
+// on how often the app polls. It is the queue's only producer while it runs;
+// the app thread only flushes requests and sleeps on x_main_wake_pipe.
+
+static void ska_linux_pipe_drain(int fd) {
+	char buffer[64];
+	while (read(fd, buffer, sizeof(buffer)) > 0) {}
+}
+
+static bool ska_linux_pipe_create(int fds[2]) {
+	if (pipe(fds) != 0) {
+		return false;
+	}
+	for (int32_t i = 0; i < 2; i++) {
+		fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL, 0) | O_NONBLOCK);
+		fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+	}
+	return true;
+}
+
+static void ska_linux_input_thread_wake(void) {
+	if (g_ska.x_input_thread_running) {
+		ssize_t written = write(g_ska.x_input_wake_pipe[1], "w", 1);
+		(void)written; // A full pipe already means a pending wake
+	}
+}
+
+// One write per wake-up at most, no matter how many batches get committed
+static void ska_linux_main_thread_wake(void) {
+	if (!atomic_exchange(&g_ska.x_main_wake_pending, true)) {
+		ssize_t written = write(g_ska.x_main_wake_pipe[1], "w", 1);
+		(void)written;
+	}
+}
+
+void ska_platform_wake(void) {
+	// Whoever posts events drains the inbox: the input thread wakes the app
+	// thread once it has committed them
+	if (g_ska.x_input_thread_running) {
+		ska_linux_input_thread_wake();
+	} else {
+		ska_linux_main_thread_wake();
+	}
+}
+
+static void* ska_linux_input_thread(void* arg) {
+	(void)arg;
+	Display* display = g_ska.x_display;
+	ska_profile_thread_name("sk_app input");
+
+	while (!atomic_load_explicit(&g_ska.x_input_thread_quit, memory_order_acquire)) {
+		int32_t count = 0;
+
+		ska_profile_begin("ska_platform_pump_events");
+		XLockDisplay(display);
+		while (XPending(display)) {
+			XEvent xev;
+			XNextEvent(display, &xev);
+
+			// Keeps ska_window_free() from pulling a window out from under us
+			ska_window_list_lock();
+			ska_linux_translate_event(&xev);
+			ska_window_list_unlock();
+			count++;
+		}
+		ska_linux_monitors_update();
+		ska_window_list_lock();
+		ska_linux_post_pending();
+		ska_window_list_unlock();
+		XUnlockDisplay(display);
+		ska_linux_note_requests();
+
+		// A dialog that stops being active has just posted its result
+		bool dialog_active = ska_linux_file_dialog_fd() >= 0;
+		ska_linux_check_file_dialog();
+		count += ska_post_inbox_events();
+		if (dialog_active && ska_linux_file_dialog_fd() < 0) {
+			count++;
+		}
+
+		if (count > 0) {
+			ska_post_event_commit();
+			ska_linux_main_thread_wake();
+		}
+		ska_profile_end();
+
+		struct pollfd fds[3];
+		nfds_t        fd_count = 0;
+		fds[fd_count].fd     = ConnectionNumber(display);
+		fds[fd_count].events = POLLIN;
+		fd_count++;
+		fds[fd_count].fd     = g_ska.x_input_wake_pipe[0];
+		fds[fd_count].events = POLLIN;
+		fd_count++;
+
+		int dialog_fd = ska_linux_file_dialog_fd();
+		if (dialog_fd >= 0) {
+			fds[fd_count].fd     = dialog_fd;
+			fds[fd_count].events = POLLIN;
+			fd_count++;
+		}
+
+		poll(fds, fd_count, -1);
+		ska_linux_pipe_drain(g_ska.x_input_wake_pipe[0]);
+	}
+	return NULL;
+}
+
+static bool ska_linux_input_thread_start(void) {
+	if (!ska_linux_pipe_create(g_ska.x_input_wake_pipe)) {
+		return false;
+	}
+
+	atomic_store(&g_ska.x_input_thread_quit,  false);
+	atomic_store(&g_ska.x_selection_ready,    false);
+
+	// Set before the thread exists so ska_post_event_commit() is never
+	// called from this thread again
+	g_ska.x_input_thread_running = true;
+	g_ska.event_producer_threaded = true;
+	if (pthread_create(&g_ska.x_input_thread, NULL, ska_linux_input_thread, NULL) != 0) {
+		g_ska.x_input_thread_running = false;
+		g_ska.event_producer_threaded = false;
+		close(g_ska.x_input_wake_pipe[0]);
+		close(g_ska.x_input_wake_pipe[1]);
+		return false;
+	}
+	return true;
+}
+
+static void ska_linux_input_thread_stop(void) {
+	if (!g_ska.x_input_thread_running) {
+		return;
+	}
+
+	atomic_store_explicit(&g_ska.x_input_thread_quit, true, memory_order_release);
+	ska_linux_input_thread_wake();
+	pthread_join(g_ska.x_input_thread, NULL);
+
+	g_ska.x_input_thread_running = false;
+	close(g_ska.x_input_wake_pipe[0]);
+	close(g_ska.x_input_wake_pipe[1]);
+
+	// Anything translated after the thread's last commit goes out on the next poll
+	g_ska.event_producer_threaded = false;
+}
+
 /////////////////////////////////////////
 // X11 specific subset of Vulkan header
 /////////////////////////////////////////
@@ -1031,54 +2040,32 @@ char* ska_platform_clipboard_get_text(void) {
 		return NULL;
 	}
 
-	Atom clipboard_atom = XInternAtom(g_ska.x_display, "CLIPBOARD",   False);
-	Atom utf8_atom      = XInternAtom(g_ska.x_display, "UTF8_STRING", False);
-	Atom property_atom  = XInternAtom(g_ska.x_display, "XSEL_DATA",   False);
+	Atom clipboard_atom = g_ska.x_atoms[ska_x_atom_clipboard];
+	Atom utf8_atom      = g_ska.x_atoms[ska_x_atom_utf8_string];
+	Atom property_atom  = g_ska.x_atoms[ska_x_atom_xsel_data];
 
 	// Find a window to use for selection requests (use first available window)
-	Window window = None;
-	for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-		if (g_ska.windows[i]) {
-			window = g_ska.windows[i]->xwindow;
-			break;
-		}
-	}
+	Window window = g_ska.window_count > 0 ? g_ska.windows[0]->xwindow : None;
 	if (window == None) return NULL;
 
-	// Check if we own the clipboard - if so, read directly from our stored data
-	// to avoid a deadlock where we'd be waiting for ourselves to respond
-	Window owner = XGetSelectionOwner(g_ska.x_display, clipboard_atom);
-	if (owner == window) {
-		Atom data_property = XInternAtom(g_ska.x_display, "SKA_CLIPBOARD_DATA", False);
-		Atom actual_type;
-		int32_t actual_format;
-		unsigned long nitems, bytes_after;
-		unsigned char* data = NULL;
-
-		int32_t result = XGetWindowProperty(
-			g_ska.x_display, window, data_property,
-			0, 0x1FFFFFFF, False, AnyPropertyType,
-			&actual_type, &actual_format, &nitems, &bytes_after, &data
-		);
-
-		if (result != Success || !data || nitems == 0) {
-			if (data) XFree(data);
-			return NULL;
-		}
-
-		char* text = (char*)malloc(nitems + 1);
+	// While we own the clipboard, answer from our copy; asking the server
+	// would have us wait on our own SelectionRequest
+	ska_window_list_lock();
+	if (g_ska.x_clipboard_text) {
+		char* text = (char*)malloc(g_ska.x_clipboard_length + 1);
 		if (text) {
-			memcpy(text, data, nitems);
-			text[nitems] = '\0';
+			memcpy(text, g_ska.x_clipboard_text, g_ska.x_clipboard_length + 1);
 		}
-
-		XFree(data);
+		ska_window_list_unlock();
 		return text;
 	}
+	ska_window_list_unlock();
 
 	// Request clipboard content from external owner
+	atomic_store_explicit(&g_ska.x_selection_ready, false, memory_order_relaxed);
+	SKA_X_ROUND_TRIP("XConvertSelection"); // Waits below for the owner's SelectionNotify
 	XConvertSelection(g_ska.x_display, clipboard_atom, utf8_atom, property_atom, window, CurrentTime);
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 
 	// Wait for SelectionNotify event with timeout
 	XEvent event;
@@ -1091,6 +2078,12 @@ char* ska_platform_clipboard_get_text(void) {
 			received = true;
 			break;
 		}
+		// Picked up by the input thread instead, see ska_linux_translate_event
+		if (atomic_load_explicit(&g_ska.x_selection_ready, memory_order_acquire)) {
+			event.xselection = g_ska.x_selection_event;
+			received = true;
+			break;
+		}
 		ska_time_sleep(1);
 	}
 
@@ -1104,6 +2097,7 @@ char* ska_platform_clipboard_get_text(void) {
 	unsigned long nitems, bytes_after;
 	unsigned char* data = NULL;
 
+	SKA_X_ROUND_TRIP("XGetWindowProperty");
 	int32_t result = XGetWindowProperty(
 		g_ska.x_display, window, property_atom,
 		0, 0x1FFFFFFF, False, AnyPropertyType,
@@ -1134,39 +2128,43 @@ bool ska_platform_clipboard_set_text(const char* text) {
 		return false;
 	}
 
-	Atom clipboard_atom = XInternAtom(g_ska.x_display, "CLIPBOARD", False);
+	Atom clipboard_atom = g_ska.x_atoms[ska_x_atom_clipboard];
 
 	// Find a window to use as selection owner
-	Window window = None;
-	for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-		if (g_ska.windows[i]) {
-			window = g_ska.windows[i]->xwindow;
-			break;
-		}
-	}
+	Window window = g_ska.window_count > 0 ? g_ska.windows[0]->xwindow : None;
 
 	if (window == None) {
 		ska_set_error("ska_platform_clipboard_set_text: no window available");
 		return false;
 	}
 
-	// Store the text in a window property
-	Atom property_atom = XInternAtom(g_ska.x_display, "SKA_CLIPBOARD_DATA", False);
-	Atom utf8_atom = XInternAtom(g_ska.x_display, "UTF8_STRING", False);
+	// Keep our own copy to serve SelectionRequests from
+	size_t length = strlen(text);
+	char*  copy   = (char*)malloc(length + 1);
+	if (!copy) {
+		ska_set_error("ska_platform_clipboard_set_text: out of memory");
+		return false;
+	}
+	memcpy(copy, text, length + 1);
 
-	XChangeProperty(
-		g_ska.x_display, window, property_atom,
-		utf8_atom, 8, PropModeReplace,
-		(const unsigned char*)text, strlen(text)
-	);
+	ska_window_list_lock();
+	free(g_ska.x_clipboard_text);
+	g_ska.x_clipboard_text   = copy;
+	g_ska.x_clipboard_length = length;
+	g_ska.x_clipboard_owner  = window;
+	ska_window_list_unlock();
 
 	// Take ownership of the clipboard
 	XSetSelectionOwner(g_ska.x_display, clipboard_atom, window, CurrentTime);
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 
 	// Verify ownership
+	SKA_X_ROUND_TRIP("XGetSelectionOwner");
 	Window owner = XGetSelectionOwner(g_ska.x_display, clipboard_atom);
 	if (owner != window) {
+		ska_window_list_lock();
+		ska_linux_clipboard_release();
+		ska_window_list_unlock();
 		ska_set_error("ska_platform_clipboard_set_text: failed to acquire clipboard ownership");
 		return false;
 	}
@@ -1186,7 +2184,7 @@ typedef struct {
 	int                      pipe_fd;
 	ska_file_dialog_id_t     id;
 	char*                    title;
-	bool                     active;
+	_Atomic bool             active; // Read by the input thread when it runs
 } ska_linux_file_dialog_t;
 
 static ska_linux_file_dialog_t g_linux_file_dialog = {0};
@@ -1349,10 +2347,17 @@ bool ska_platform_file_dialog_show(ska_file_dialog_id_t id, const ska_file_dialo
 	g_linux_file_dialog.title = request->title ? strdup(request->title) : NULL;
 	g_linux_file_dialog.active = true;
 
+	// Have the input thread start watching the new pipe
+	ska_linux_input_thread_wake();
+
 	return true;
 }
 
-// Called from ska_platform_pump_events to check for dialog completion
+static int ska_linux_file_dialog_fd(void) {
+	return g_linux_file_dialog.active ? g_linux_file_dialog.pipe_fd : -1;
+}
+
+// Called by whichever thread reads X events, see ska_platform_pump_events
 static void ska_linux_check_file_dialog(void) {
 	if (!g_linux_file_dialog.active) return;
 
@@ -1457,7 +2462,7 @@ bool ska_platform_window_set_icon(ska_window_t* ref_window, const uint8_t* pixel
 		                   ((unsigned long)g << 8)  | ((unsigned long)b);
 	}
 
-	Atom net_wm_icon = XInternAtom(g_ska.x_display, "_NET_WM_ICON", False);
+	Atom net_wm_icon = g_ska.x_atoms[ska_x_atom_net_wm_icon];
 
 	XChangeProperty(
 		g_ska.x_display,
@@ -1470,7 +2475,7 @@ bool ska_platform_window_set_icon(ska_window_t* ref_window, const uint8_t* pixel
 		(int)data_size
 	);
 
-	XFlush(g_ska.x_display);
+	ska_linux_flush();
 
 	free(icon_data);
 	return true;
@@ -117,12 +117,7 @@ static void ska_init_scancode_table(void) {
 }
 
 static ska_window_t* ska_find_window_by_nswindow(NSWindow* nswindow) {
-	for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-		if (g_ska.windows[i] && g_ska.windows[i]->ns_window == nswindow) {
-			return g_ska.windows[i];
-		}
-	}
-	return NULL;
+	return ska_window_from_native((uintptr_t)(__bridge void*)nswindow);
 }
 
 static uint16_t ska_macos_get_modifiers(NSEventModifierFlags flags) {
@@ -344,6 +339,7 @@ bool ska_platform_window_create(
 		}
 
 		window->ns_window = nswindow;
+		ska_window_set_native(window, (uintptr_t)(__bridge void*)nswindow);
 
 		/* Set title */
 		NSString* ns_title = [NSString stringWithUTF8String:title];
@@ -400,6 +396,7 @@ void ska_platform_window_destroy(ska_window_t* window) {
 			NSWindow* nswindow = (NSWindow*)window->ns_window;
 			[nswindow setDelegate:nil];
 			[nswindow close];
+			ska_window_set_native(window, 0);
 			window->ns_window = nil;
 			window->ns_view = nil;
 		}
@@ -540,6 +537,32 @@ float ska_platform_get_dpi_scale(const ska_window_t* window) {
 	}
 }
 
+static float ska_macos_screen_refresh_rate(NSScreen* screen) {
+	/* Get the CGDirectDisplayID from the screen */
+	NSDictionary* description = [screen deviceDescription];
+	NSNumber* screenNumber = [description objectForKey:@"NSScreenNumber"];
+	if (!screenNumber) {
+		return 0.0f;
+	}
+
+	CGDirectDisplayID displayID = [screenNumber unsignedIntValue];
+	CGDisplayModeRef mode = CGDisplayCopyDisplayMode(displayID);
+	if (!mode) {
+		return 0.0f;
+	}
+
+	double rate = CGDisplayModeGetRefreshRate(mode);
+	CGDisplayModeRelease(mode);
+
+	/* Some displays (especially built-in) may report 0 for refresh rate.
+	 * In that case, fall back to a reasonable default. */
+	if (rate <= 0.0) {
+		return 60.0f;
+	}
+
+	return (float)rate;
+}
+
 float ska_platform_get_refresh_rate(const ska_window_t* window) {
 	@autoreleasepool {
 		NSScreen* screen = nil;
@@ -557,29 +580,48 @@ float ska_platform_get_refresh_rate(const ska_window_t* window) {
 			return 0.0f;
 		}
 
-		/* Get the CGDirectDisplayID from the screen */
-		NSDictionary* description = [screen deviceDescription];
-		NSNumber* screenNumber = [description objectForKey:@"NSScreenNumber"];
-		if (!screenNumber) {
-			return 0.0f;
-		}
-
-		CGDirectDisplayID displayID = [screenNumber unsignedIntValue];
-		CGDisplayModeRef mode = CGDisplayCopyDisplayMode(displayID);
-		if (!mode) {
-			return 0.0f;
-		}
+		return ska_macos_screen_refresh_rate(screen);
+	}
+}
 
-		double rate = CGDisplayModeGetRefreshRate(mode);
-		CGDisplayModeRelease(mode);
+int32_t ska_platform_display_count(void) {
+	@autoreleasepool {
+		/* AppKit keeps [NSScreen screens] current, no cache needed */
+		return (int32_t)[[NSScreen screens] count];
+	}
+}
 
-		/* Some displays (especially built-in) may report 0 for refresh rate.
-		 * In that case, fall back to a reasonable default. */
-		if (rate <= 0.0) {
-			return 60.0f;
+bool ska_platform_display_get_info(int32_t index, ska_display_info_t* out_info) {
+	@autoreleasepool {
+		NSArray* screens = [NSScreen screens];
+		if (index < 0 || index >= (int32_t)[screens count]) {
+			return false;
 		}
-
-		return (float)rate;
+		NSScreen* screen = [screens objectAtIndex:(NSUInteger)index];
+
+		/* Flip to top-left origin the same way window positions are */
+		CGFloat flip_height = [NSScreen mainScreen].frame.size.height;
+		NSRect  frame       = screen.frame;
+		NSRect  visible     = screen.visibleFrame;
+		out_info->x            = (int32_t)frame.origin.x;
+		out_info->y            = (int32_t)(flip_height - frame.origin.y - frame.size.height);
+		out_info->width        = (int32_t)frame.size.width;
+		out_info->height       = (int32_t)frame.size.height;
+		out_info->work_x       = (int32_t)visible.origin.x;
+		out_info->work_y       = (int32_t)(flip_height - visible.origin.y - visible.size.height);
+		out_info->work_width   = (int32_t)visible.size.width;
+		out_info->work_height  = (int32_t)visible.size.height;
+		out_info->refresh_rate = ska_macos_screen_refresh_rate(screen);
+		out_info->dpi_scale    = ska_platform_get_dpi_scale(NULL);
+		out_info->is_primary   = index == 0; /* The first screen has the menu bar */
+
+		if (@available(macOS 10.15, *)) {
+			const char* name = [[screen localizedName] UTF8String];
+			if (name) {
+				snprintf(out_info->name, sizeof(out_info->name), "%s", name);
+			}
+		}
+		return true;
 	}
 }
 
@@ -812,6 +854,35 @@ void ska_platform_pump_events(void) {
 /* Forward declaration for file dialog check */
 static void ska_macos_check_file_dialog(void);
 
+void ska_platform_wait_events(int32_t timeout_ms) {
+	@autoreleasepool {
+		/* Leave the event queued, ska_platform_pump_events() dequeues it */
+		NSDate* until = timeout_ms < 0
+			? [NSDate distantFuture]
+			: [NSDate dateWithTimeIntervalSinceNow:(double)timeout_ms / 1000.0];
+		[NSApp nextEventMatchingMask:NSEventMaskAny
+		                   untilDate:until
+		                      inMode:NSDefaultRunLoopMode
+		                     dequeue:NO];
+	}
+}
+
+void ska_platform_wake(void) {
+	/* postEvent is safe from any thread, the pump hands it to sendEvent which ignores it */
+	@autoreleasepool {
+		NSEvent* wake = [NSEvent otherEventWithType:NSEventTypeApplicationDefined
+		                                   location:NSZeroPoint
+		                              modifierFlags:0
+		                                  timestamp:0
+		                               windowNumber:0
+		                                    context:nil
+		                                    subtype:0
+		                                      data1:0
+		                                      data2:0];
+		[NSApp postEvent:wake atStart:NO];
+	}
+}
+
 /////////////////////////////////////////
 // macOS specific subset of Vulkan header
 /////////////////////////////////////////
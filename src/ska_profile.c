@@ -0,0 +1,206 @@
+//
+// sk_app - Profiler
+//
+// Every thread that opens a zone gets a ring of begin/end records. Only that
+// thread writes to it, publishing each record by bumping write_pos, so
+// recording is a clock read and two stores. ska_profile_dump() copies a ring,
+// then re-reads write_pos and drops whatever the owner may have overwritten
+// in the meantime. Rings are never freed, a thread's zones stay dumpable
+// after it exits.
+//
+// Built only with SKA_PROFILE, otherwise sk_app.h turns the API into no-ops.
+
+#include "ska_internal.h"
+
+#ifdef SKA_PROFILE
+
+#define SKA_PROFILE_RING_SIZE   (1u << 16) // Records per thread, power of two
+#define SKA_PROFILE_MAX_THREADS 64
+
+#if defined(_MSC_VER)
+	#define SKA_PROFILE_THREAD_LOCAL __declspec(thread)
+#else
+	#define SKA_PROFILE_THREAD_LOCAL _Thread_local
+#endif
+
+typedef struct ska_profile_record_t {
+	uint64_t    time_ns; // ska_time_get_elapsed_ns() clock
+	const char* name;    // NULL closes the innermost zone
+} ska_profile_record_t;
+
+typedef struct ska_profile_ring_t {
+	_Atomic uint64_t     write_pos;
+	const char*          thread_name;
+	ska_profile_record_t records[SKA_PROFILE_RING_SIZE];
+} ska_profile_ring_t;
+
+typedef struct ska_profile_state_t {
+	ska_profile_ring_t* _Atomic rings[SKA_PROFILE_MAX_THREADS];
+	_Atomic uint32_t            ring_count;
+} ska_profile_state_t;
+
+static ska_profile_state_t g_ska_profile = {0};
+
+// NULL until the thread's first zone, ska_profile_ring_none if it got no ring
+static SKA_PROFILE_THREAD_LOCAL ska_profile_ring_t* ska_profile_thread_ring = NULL;
+static ska_profile_ring_t ska_profile_ring_none;
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+static ska_profile_ring_t* ska_profile_ring_get(void) {
+	ska_profile_ring_t* ring = ska_profile_thread_ring;
+	if (ring) {
+		return ring == &ska_profile_ring_none ? NULL : ring;
+	}
+
+	// First zone on this thread, claim a slot
+	ska_profile_thread_ring = &ska_profile_ring_none;
+	uint32_t index = atomic_fetch_add_explicit(&g_ska_profile.ring_count, 1, memory_order_relaxed);
+	if (index >= SKA_PROFILE_MAX_THREADS) {
+		return NULL;
+	}
+	ring = (ska_profile_ring_t*)calloc(1, sizeof(ska_profile_ring_t));
+	if (!ring) {
+		return NULL;
+	}
+	atomic_store_explicit(&g_ska_profile.rings[index], ring, memory_order_release);
+	ska_profile_thread_ring = ring;
+	return ring;
+}
+
+static void ska_profile_record(const char* name) {
+	ska_profile_ring_t* ring = ska_profile_ring_get();
+	if (!ring) {
+		return;
+	}
+
+	uint64_t pos = atomic_load_explicit(&ring->write_pos, memory_order_relaxed);
+	ska_profile_record_t* record = &ring->records[pos & (SKA_PROFILE_RING_SIZE - 1)];
+	record->time_ns = ska_time_get_elapsed_ns();
+	record->name    = name;
+	atomic_store_explicit(&ring->write_pos, pos + 1, memory_order_release);
+}
+
+// ============================================================================
+// Export
+// ============================================================================
+
+static void ska_profile_write_string(FILE* file, const char* str) {
+	fputc('"', file);
+	for (const unsigned char* c = (const unsigned char*)str; *c; c++) {
+		if      (*c == '"' || *c == '\\') fprintf(file, "\\%c", *c);
+		else if (*c < 0x20)               fprintf(file, "\\u%04x", *c);
+		else                              fputc(*c, file);
+	}
+	fputc('"', file);
+}
+
+// Writes one ring's zones, returns false if nothing was written
+static bool ska_profile_write_ring(FILE* file, const ska_profile_ring_t* ring, uint32_t tid, ska_profile_record_t* scratch, bool first) {
+	uint64_t end   = atomic_load_explicit(&ring->write_pos, memory_order_acquire);
+	uint64_t start = end > SKA_PROFILE_RING_SIZE ? end - SKA_PROFILE_RING_SIZE : 0;
+	for (uint64_t i = start; i < end; i++) {
+		scratch[i - start] = ring->records[i & (SKA_PROFILE_RING_SIZE - 1)];
+	}
+
+	// The owner kept recording during the copy, skip what it may have overwritten
+	uint64_t after = atomic_load_explicit(&ring->write_pos, memory_order_acquire);
+	uint64_t valid = after > SKA_PROFILE_RING_SIZE ? after - SKA_PROFILE_RING_SIZE : 0;
+	uint64_t skip  = valid > start ? valid - start : 0;
+	if (skip >= end - start) {
+		return false;
+	}
+
+	if (!first) fputs(",\n", file);
+	fprintf(file, "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", tid);
+	if (ring->thread_name) {
+		ska_profile_write_string(file, ring->thread_name);
+	} else {
+		fprintf(file, "\"Thread %u\"", tid);
+	}
+	fputs("}}", file);
+
+	// Ends whose begin was dropped with the oldest records are left out
+	int32_t depth = 0;
+	for (uint64_t i = skip; i < end - start; i++) {
+		const ska_profile_record_t* record = &scratch[i];
+		if (!record->name && depth == 0) {
+			continue;
+		}
+		depth += record->name ? 1 : -1;
+
+		fprintf(file, ",\n{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%llu.%03u",
+			record->name ? 'B' : 'E', tid,
+			(unsigned long long)(record->time_ns / 1000), (unsigned)(record->time_ns % 1000));
+		if (record->name) {
+			fputs(",\"name\":", file);
+			ska_profile_write_string(file, record->name);
+		}
+		fputc('}', file);
+	}
+	return true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+SKA_API void ska_profile_begin(const char* name) {
+	ska_profile_record(name ? name : "(null)");
+}
+
+SKA_API void ska_profile_end(void) {
+	ska_profile_record(NULL);
+}
+
+SKA_API void ska_profile_thread_name(const char* name) {
+	ska_profile_ring_t* ring = ska_profile_ring_get();
+	if (ring) {
+		ring->thread_name = name;
+	}
+}
+
+SKA_API bool ska_profile_dump(const char* path) {
+	if (!path) {
+		ska_set_error("ska_profile_dump: NULL path");
+		return false;
+	}
+
+	ska_profile_record_t* scratch = (ska_profile_record_t*)malloc(SKA_PROFILE_RING_SIZE * sizeof(ska_profile_record_t));
+	if (!scratch) {
+		ska_set_error("ska_profile_dump: Out of memory");
+		return false;
+	}
+
+	FILE* file = fopen(path, "wb");
+	if (!file) {
+		ska_set_error("ska_profile_dump: Failed to open '%s' for writing", path);
+		free(scratch);
+		return false;
+	}
+
+	fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+	uint32_t count = atomic_load_explicit(&g_ska_profile.ring_count, memory_order_relaxed);
+	if (count > SKA_PROFILE_MAX_THREADS) count = SKA_PROFILE_MAX_THREADS;
+	bool first = true;
+	for (uint32_t i = 0; i < count; i++) {
+		// A thread may have claimed the slot but not published its ring yet
+		const ska_profile_ring_t* ring = atomic_load_explicit(&g_ska_profile.rings[i], memory_order_acquire);
+		if (ring && ska_profile_write_ring(file, ring, i + 1, scratch, first)) {
+			first = false;
+		}
+	}
+	fputs("\n]}\n", file);
+
+	free(scratch);
+	bool ok = !ferror(file);
+	if (fclose(file) != 0) ok = false;
+	if (!ok) {
+		ska_set_error("ska_profile_dump: Failed to write '%s'", path);
+	}
+	return ok;
+}
+
+#endif // SKA_PROFILE
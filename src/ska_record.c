@@ -0,0 +1,510 @@
+//
+// sk_app - Event recording and replay
+//
+// Log format: an 8-byte header ("SKAREC" + little-endian uint16 version),
+// then one record per event:
+//
+//   uint8   type          ska_event_
+//   uint8   size          payload bytes that follow the varints
+//   varint  delta_ns      timestamp_ns minus the previous record's
+//   varint  window_id
+//   payload               little-endian, layout depends on type
+//
+// Unknown types are skipped using size, so newer logs still replay the
+// events an older build understands.
+
+#include "ska_internal.h"
+
+#define SKA_RECORD_MAGIC      "SKAREC"
+#define SKA_RECORD_VERSION    1
+#define SKA_RECORD_HEADER     8
+#define SKA_RECORD_MAX        (2 + 10 + 5 + 32) // Largest possible record
+#define SKA_REPLAY_BATCH      256               // Events queued per pump at max speed
+
+typedef struct ska_record_state_t {
+	FILE*    file;
+	uint64_t last_ns;
+
+	uint8_t* replay_data;
+	size_t   replay_size;
+	size_t   replay_pos;
+	float    replay_speed;      // <= 0 replays as fast as the app polls
+	uint64_t replay_start_ns;   // Local time replay started
+	uint64_t replay_first_ns;   // Timestamp of the first record
+	uint64_t replay_record_ns;  // Timestamp of the record at replay_pos
+	uint64_t replay_dropped;    // Replayed events lost to a full queue
+} ska_record_state_t;
+
+static ska_record_state_t g_ska_record = {0};
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+static uint8_t* ska_record_put_varint(uint8_t* out, uint64_t value) {
+	while (value >= 0x80) {
+		*out++ = (uint8_t)(value | 0x80);
+		value >>= 7;
+	}
+	*out++ = (uint8_t)value;
+	return out;
+}
+
+static uint8_t* ska_record_put_u16(uint8_t* out, uint16_t value) {
+	out[0] = (uint8_t)(value);
+	out[1] = (uint8_t)(value >> 8);
+	return out + 2;
+}
+
+static uint8_t* ska_record_put_u32(uint8_t* out, uint32_t value) {
+	out[0] = (uint8_t)(value);
+	out[1] = (uint8_t)(value >> 8);
+	out[2] = (uint8_t)(value >> 16);
+	out[3] = (uint8_t)(value >> 24);
+	return out + 4;
+}
+
+static uint8_t* ska_record_put_f32(uint8_t* out, float value) {
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return ska_record_put_u32(out, bits);
+}
+
+// Writes the payload for event, returns its end
+static uint8_t* ska_record_put_payload(uint8_t* out, const ska_event_t* event) {
+	switch (event->type) {
+	case ska_event_key_down:
+	case ska_event_key_up:
+		out = ska_record_put_u16(out, (uint16_t)event->keyboard.scancode);
+		out = ska_record_put_u16(out, event->keyboard.modifiers);
+		*out++ = (uint8_t)((event->keyboard.pressed ? 1 : 0) | (event->keyboard.repeat ? 2 : 0));
+		break;
+
+	case ska_event_text_input: {
+		size_t length = strlen(event->text.text);
+		memcpy(out, event->text.text, length);
+		out += length;
+		break;
+	}
+
+	case ska_event_mouse_motion:
+		out = ska_record_put_u32(out, (uint32_t)event->mouse_motion.x);
+		out = ska_record_put_u32(out, (uint32_t)event->mouse_motion.y);
+		out = ska_record_put_u32(out, (uint32_t)event->mouse_motion.xrel);
+		out = ska_record_put_u32(out, (uint32_t)event->mouse_motion.yrel);
+		break;
+
+	case ska_event_mouse_button_down:
+	case ska_event_mouse_button_up:
+		*out++ = (uint8_t)event->mouse_button.button;
+		*out++ = event->mouse_button.clicks;
+		*out++ = event->mouse_button.pressed ? 1 : 0;
+		out = ska_record_put_u32(out, (uint32_t)event->mouse_button.x);
+		out = ska_record_put_u32(out, (uint32_t)event->mouse_button.y);
+		break;
+
+	case ska_event_mouse_wheel:
+		out = ska_record_put_u32(out, (uint32_t)event->mouse_wheel.x);
+		out = ska_record_put_u32(out, (uint32_t)event->mouse_wheel.y);
+		out = ska_record_put_f32(out, event->mouse_wheel.precise_x);
+		out = ska_record_put_f32(out, event->mouse_wheel.precise_y);
+		break;
+
+	default:
+		// Window, app and quit events
+		out = ska_record_put_u32(out, (uint32_t)event->window.data1);
+		out = ska_record_put_u32(out, (uint32_t)event->window.data2);
+		break;
+	}
+	return out;
+}
+
+static ska_window_id_t ska_record_window_id(const ska_event_t* event) {
+	switch (event->type) {
+	case ska_event_key_down:
+	case ska_event_key_up:            return event->keyboard.window_id;
+	case ska_event_text_input:        return event->text.window_id;
+	case ska_event_mouse_motion:      return event->mouse_motion.window_id;
+	case ska_event_mouse_button_down:
+	case ska_event_mouse_button_up:   return event->mouse_button.window_id;
+	case ska_event_mouse_wheel:       return event->mouse_wheel.window_id;
+	default:                          return event->window.window_id;
+	}
+}
+
+void ska_record_events(const ska_event_t* events, int32_t count) {
+	for (int32_t i = 0; i < count; i++) {
+		const ska_event_t* event = &events[i];
+
+		// Dialog results and user pointers only live as long as this session
+		if (event->type == ska_event_file_dialog || event->type == ska_event_user || event->type == ska_event_timer) {
+			continue;
+		}
+
+		uint8_t payload[32];
+		uint8_t size = (uint8_t)(ska_record_put_payload(payload, event) - payload);
+
+		uint64_t delta_ns = event->timestamp_ns >= g_ska_record.last_ns
+			? event->timestamp_ns - g_ska_record.last_ns
+			: 0;
+		g_ska_record.last_ns += delta_ns;
+
+		uint8_t  record[SKA_RECORD_MAX];
+		uint8_t* out = record;
+		*out++ = (uint8_t)event->type;
+		*out++ = size;
+		out = ska_record_put_varint(out, delta_ns);
+		out = ska_record_put_varint(out, ska_record_window_id(event));
+		memcpy(out, payload, size);
+		out += size;
+
+		if (fwrite(record, 1, (size_t)(out - record), g_ska_record.file) != (size_t)(out - record)) {
+			ska_log(ska_log_error, "Event recording failed to write, stopping");
+			ska_record_stop();
+			return;
+		}
+	}
+}
+
+SKA_API bool ska_record_start(const char* path) {
+	if (!path) {
+		ska_set_error("ska_record_start: NULL path");
+		return false;
+	}
+
+	ska_record_stop();
+
+	FILE* file = fopen(path, "wb");
+	if (!file) {
+		ska_set_error("ska_record_start: Failed to open '%s' for writing", path);
+		return false;
+	}
+
+	uint8_t header[SKA_RECORD_HEADER];
+	memcpy(header, SKA_RECORD_MAGIC, 6);
+	ska_record_put_u16(header + 6, SKA_RECORD_VERSION);
+	if (fwrite(header, 1, sizeof(header), file) != sizeof(header)) {
+		ska_set_error("ska_record_start: Failed to write '%s'", path);
+		fclose(file);
+		return false;
+	}
+
+	g_ska_record.file    = file;
+	g_ska_record.last_ns = 0;
+	g_ska.recording      = true;
+	return true;
+}
+
+SKA_API void ska_record_stop(void) {
+	if (g_ska_record.file) {
+		fclose(g_ska_record.file);
+		g_ska_record.file = NULL;
+	}
+	g_ska.recording = false;
+}
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+static bool ska_replay_get_varint(const uint8_t** ref_in, const uint8_t* end, uint64_t* out_value) {
+	const uint8_t* in = *ref_in;
+	uint64_t value = 0;
+	for (int32_t shift = 0; shift < 64; shift += 7) {
+		if (in >= end) return false;
+		uint8_t byte = *in++;
+		value |= (uint64_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			*ref_in    = in;
+			*out_value = value;
+			return true;
+		}
+	}
+	return false;
+}
+
+static uint16_t ska_replay_get_u16(const uint8_t* in) {
+	return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint32_t ska_replay_get_u32(const uint8_t* in) {
+	return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+static float ska_replay_get_f32(const uint8_t* in) {
+	uint32_t bits = ska_replay_get_u32(in);
+	float    value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+// Decodes the record at replay_pos. Returns false at the end of the log or
+// on a truncated record, true with out_known = false for unknown types.
+// Recorded window ids carry the generation their slot had in the recorded
+// session, which the replaying session only matches if it created and
+// destroyed windows the same way. An id that doesn't resolve goes to whatever
+// window now holds its slot, and stays as recorded (resolving to nothing) if
+// the slot is empty.
+static ska_window_id_t ska_replay_map_window(ska_window_id_t id) {
+	if (id == 0 || ska_window_from_id(id)) {
+		return id;
+	}
+	uint32_t slot = id & SKA_WINDOW_SLOT_MASK;
+	if (slot == 0 || slot > g_ska.window_slot_count || !g_ska.window_slots[slot - 1].window) {
+		return id;
+	}
+	return g_ska.window_slots[slot - 1].window->id;
+}
+
+static bool ska_replay_decode(ska_event_t* out_event, uint64_t* out_timestamp_ns, size_t* out_next, bool* out_known) {
+	const uint8_t* in  = g_ska_record.replay_data + g_ska_record.replay_pos;
+	const uint8_t* end = g_ska_record.replay_data + g_ska_record.replay_size;
+	if (end - in < 2) return false;
+
+	ska_event_ type = (ska_event_)in[0];
+	uint8_t    size = in[1];
+	in += 2;
+
+	uint64_t delta_ns, window_id;
+	if (!ska_replay_get_varint(&in, end, &delta_ns))  return false;
+	if (!ska_replay_get_varint(&in, end, &window_id)) return false;
+	window_id = ska_replay_map_window((ska_window_id_t)window_id);
+	if ((size_t)(end - in) < size)                    return false;
+
+	*out_timestamp_ns = g_ska_record.replay_record_ns + delta_ns;
+	*out_next         = (size_t)(in + size - g_ska_record.replay_data);
+	*out_known        = true;
+
+	memset(out_event, 0, sizeof(*out_event));
+	out_event->type = type;
+
+	switch (type) {
+	case ska_event_key_down:
+	case ska_event_key_up:
+		if (size < 5) break;
+		out_event->keyboard.window_id = (ska_window_id_t)window_id;
+		out_event->keyboard.scancode  = (ska_scancode_)ska_replay_get_u16(in);
+		out_event->keyboard.modifiers = ska_replay_get_u16(in + 2);
+		out_event->keyboard.pressed   = (in[4] & 1) != 0;
+		out_event->keyboard.repeat    = (in[4] & 2) != 0;
+		return true;
+
+	case ska_event_text_input:
+		if (size >= sizeof(out_event->text.text)) break;
+		out_event->text.window_id = (ska_window_id_t)window_id;
+		memcpy(out_event->text.text, in, size);
+		return true;
+
+	case ska_event_mouse_motion:
+		if (size < 16) break;
+		out_event->mouse_motion.window_id = (ska_window_id_t)window_id;
+		out_event->mouse_motion.x         = (int32_t)ska_replay_get_u32(in);
+		out_event->mouse_motion.y         = (int32_t)ska_replay_get_u32(in + 4);
+		out_event->mouse_motion.xrel      = (int32_t)ska_replay_get_u32(in + 8);
+		out_event->mouse_motion.yrel      = (int32_t)ska_replay_get_u32(in + 12);
+		return true;
+
+	case ska_event_mouse_button_down:
+	case ska_event_mouse_button_up:
+		// The button indexes the mouse_buttons bitmask, so anything the
+		// backends can't produce is treated like an unknown record
+		if (size < 11 || in[0] < ska_mouse_button_left || in[0] > ska_mouse_button_x2) break;
+		out_event->mouse_button.window_id = (ska_window_id_t)window_id;
+		out_event->mouse_button.button    = (ska_mouse_button_)in[0];
+		out_event->mouse_button.clicks    = in[1];
+		out_event->mouse_button.pressed   = in[2] != 0;
+		out_event->mouse_button.x         = (int32_t)ska_replay_get_u32(in + 3);
+		out_event->mouse_button.y         = (int32_t)ska_replay_get_u32(in + 7);
+		return true;
+
+	case ska_event_mouse_wheel:
+		if (size < 16) break;
+		out_event->mouse_wheel.window_id = (ska_window_id_t)window_id;
+		out_event->mouse_wheel.x         = (int32_t)ska_replay_get_u32(in);
+		out_event->mouse_wheel.y         = (int32_t)ska_replay_get_u32(in + 4);
+		out_event->mouse_wheel.precise_x = ska_replay_get_f32(in + 8);
+		out_event->mouse_wheel.precise_y = ska_replay_get_f32(in + 12);
+		return true;
+
+	case ska_event_file_dialog:
+	case ska_event_user:
+	case ska_event_timer:
+		break;
+
+	default:
+		if (type > ska_event_display_changed || size < 8) break;
+		out_event->window.window_id = (ska_window_id_t)window_id;
+		out_event->window.data1     = (int32_t)ska_replay_get_u32(in);
+		out_event->window.data2     = (int32_t)ska_replay_get_u32(in + 4);
+		return true;
+	}
+
+	*out_known = false;
+	return true;
+}
+
+// Keeps state queries (ska_keyboard_get_state and friends) in step with the
+// replayed events, the way the platform backends do while translating
+static void ska_replay_apply_input(const ska_event_t* event) {
+	ska_input_state_t* input = &g_ska.input_state;
+	switch (event->type) {
+	case ska_event_key_down:
+	case ska_event_key_up:
+		if ((uint32_t)event->keyboard.scancode < ska_scancode_count) {
+			input->keyboard[event->keyboard.scancode] = event->keyboard.pressed ? 1 : 0;
+		}
+		input->key_modifiers = event->keyboard.modifiers;
+		break;
+
+	case ska_event_mouse_motion:
+		input->mouse_x = event->mouse_motion.x;
+		input->mouse_y = event->mouse_motion.y;
+		break;
+
+	case ska_event_mouse_button_down:
+	case ska_event_mouse_button_up: {
+		uint32_t button_mask = (1u << (event->mouse_button.button - 1));
+		if (event->mouse_button.pressed) {
+			input->mouse_buttons |= button_mask;
+		} else {
+			input->mouse_buttons &= ~button_mask;
+		}
+		break;
+	}
+
+	default:
+		break;
+	}
+}
+
+// Local time the record at replay_pos is due
+static uint64_t ska_replay_due_ns(uint64_t timestamp_ns) {
+	uint64_t offset_ns = timestamp_ns - g_ska_record.replay_first_ns;
+	return g_ska_record.replay_start_ns + (uint64_t)((double)offset_ns / g_ska_record.replay_speed);
+}
+
+void ska_replay_pump(void) {
+	uint64_t now_ns = ska_time_get_elapsed_ns();
+	bool     paced  = g_ska_record.replay_speed > 0.0f;
+	int32_t  posted = 0;
+
+	while (paced || posted < SKA_REPLAY_BATCH) {
+		ska_event_t event;
+		uint64_t    timestamp_ns;
+		size_t      next;
+		bool        known;
+		if (!ska_replay_decode(&event, &timestamp_ns, &next, &known)) {
+			if (g_ska_record.replay_dropped > 0) {
+				ska_log(ska_log_warn, "Event replay finished, %llu events dropped on a full queue",
+					(unsigned long long)g_ska_record.replay_dropped);
+			} else {
+				ska_log(ska_log_info, "Event replay finished");
+			}
+			ska_replay_stop();
+			break;
+		}
+
+		uint64_t due_ns = paced ? ska_replay_due_ns(timestamp_ns) : now_ns;
+		if (due_ns > now_ns) {
+			break;
+		}
+
+		g_ska_record.replay_pos       = next;
+		g_ska_record.replay_record_ns = timestamp_ns;
+		if (!known) {
+			continue;
+		}
+
+		// The log holds what the app saw after coalescing, so it must not merge
+		// again, but the enabled mask and hooks still apply
+		ska_replay_apply_input(&event);
+		event.timestamp_ns = due_ns;
+		if (!ska_post_replayed_event(&event)) {
+			g_ska_record.replay_dropped++;
+		}
+		posted++;
+	}
+
+	ska_post_event_commit();
+}
+
+int32_t ska_replay_wait_ms(void) {
+	if (g_ska_record.replay_speed <= 0.0f) {
+		return 0;
+	}
+
+	ska_event_t event;
+	uint64_t    timestamp_ns;
+	size_t      next;
+	bool        known;
+	if (!ska_replay_decode(&event, &timestamp_ns, &next, &known)) {
+		return 0;
+	}
+
+	uint64_t due_ns = ska_replay_due_ns(timestamp_ns);
+	uint64_t now_ns = ska_time_get_elapsed_ns();
+	return due_ns > now_ns ? (int32_t)((due_ns - now_ns + 999999ULL) / 1000000ULL) : 0;
+}
+
+SKA_API bool ska_replay_start(const char* path, float speed) {
+	if (!g_ska.initialized) {
+		ska_set_error("ska_replay_start: sk_app not initialized");
+		return false;
+	}
+	if (g_ska.event_producer_threaded) {
+		ska_set_error("ska_replay_start: Not available while a platform thread produces events");
+		return false;
+	}
+
+	void*  data = NULL;
+	size_t size = 0;
+	if (!ska_file_read(path, &data, &size)) {
+		return false;
+	}
+
+	const uint8_t* header = (const uint8_t*)data;
+	if (size < SKA_RECORD_HEADER || memcmp(header, SKA_RECORD_MAGIC, 6) != 0) {
+		ska_set_error("ska_replay_start: '%s' is not an event recording", path);
+		free(data);
+		return false;
+	}
+	if (ska_replay_get_u16(header + 6) != SKA_RECORD_VERSION) {
+		ska_set_error("ska_replay_start: '%s' has unsupported version %u", path, ska_replay_get_u16(header + 6));
+		free(data);
+		return false;
+	}
+
+	ska_replay_stop();
+	g_ska_record.replay_data      = (uint8_t*)data;
+	g_ska_record.replay_size      = size;
+	g_ska_record.replay_pos       = SKA_RECORD_HEADER;
+	g_ska_record.replay_speed     = speed;
+	g_ska_record.replay_start_ns  = ska_time_get_elapsed_ns();
+	g_ska_record.replay_record_ns = 0;
+	g_ska_record.replay_dropped   = 0;
+
+	// Pace from the first event, not from when the recording started
+	ska_event_t event;
+	size_t      next;
+	bool        known;
+	if (!ska_replay_decode(&event, &g_ska_record.replay_first_ns, &next, &known)) {
+		g_ska_record.replay_first_ns = 0;
+	}
+
+	g_ska.replaying = true;
+	return true;
+}
+
+SKA_API void ska_replay_stop(void) {
+	if (g_ska_record.replay_data) {
+		free(g_ska_record.replay_data);
+		g_ska_record.replay_data = NULL;
+	}
+	g_ska_record.replay_size = 0;
+	g_ska_record.replay_pos  = 0;
+	g_ska.replaying = false;
+}
+
+SKA_API bool ska_replay_is_active(void) {
+	return g_ska.replaying;
+}
@@ -50,28 +50,50 @@ static uint32_t ska_utf8_decode(const char** utf8_ptr) {
 // Text Queue Implementation
 // ============================================================================
 
+// Single-producer/single-consumer: the producer owns write_pos, the consumer
+// owns read_pos, and each publishes its position with release ordering.
+
 void ska_text_queue_init(ska_text_queue_t* queue) {
 	memset(queue, 0, sizeof(*queue));
+	atomic_init(&queue->write_pos, 0);
+	atomic_init(&queue->read_pos,  0);
 }
 
 void ska_text_queue_push_utf8(ska_text_queue_t* queue, const char* utf8) {
 	if (!utf8) return;
 
-	const char* ptr = utf8;
+	uint32_t write_pos = atomic_load_explicit(&queue->write_pos, memory_order_relaxed);
+	uint32_t read_pos  = atomic_load_explicit(&queue->read_pos,  memory_order_acquire);
+
+	const char* ptr     = utf8;
+	uint32_t    dropped = 0;
 	while (*ptr) {
 		uint32_t codepoint = ska_utf8_decode(&ptr);
 		if (codepoint != 0) {
-			// Inline ska_text_queue_push
-			if (queue->count >= SKA_TEXT_QUEUE_SIZE) {
-				ska_log(ska_log_warn, "Text queue full, dropping codepoint U+%04X", codepoint);
-				break;
+			if (dropped > 0) {
+				dropped++; // Keep the text in order, everything after the first drop goes too
+				continue;
+			}
+			if (write_pos - read_pos >= SKA_TEXT_QUEUE_SIZE) {
+				// Re-check in case the consumer made room meanwhile
+				read_pos = atomic_load_explicit(&queue->read_pos, memory_order_acquire);
+				if (write_pos - read_pos >= SKA_TEXT_QUEUE_SIZE) {
+					ska_log(ska_log_warn, "Text queue full, dropping codepoint U+%04X", codepoint);
+					dropped++;
+					continue;
+				}
 			}
 
-			queue->codepoints[queue->write_pos] = codepoint;
-			queue->write_pos = (queue->write_pos + 1) % SKA_TEXT_QUEUE_SIZE;
-			queue->count++;
+			queue->codepoints[write_pos & (SKA_TEXT_QUEUE_SIZE - 1)] = codepoint;
+			write_pos++;
 		}
 	}
+
+	// Publish the whole string at once
+	atomic_store_explicit(&queue->write_pos, write_pos, memory_order_release);
+	if (dropped > 0) {
+		ska_stats_add(text_codepoints_dropped, dropped);
+	}
 }
 
 // ============================================================================
@@ -80,35 +102,39 @@ void ska_text_queue_push_utf8(ska_text_queue_t* queue, const char* utf8) {
 
 SKA_API bool ska_text_has_input(void) {
 	ska_text_queue_t* queue = &g_ska.input_state.text_queue;
-	return queue->count != 0;
+	return atomic_load_explicit(&queue->read_pos,  memory_order_relaxed) !=
+	       atomic_load_explicit(&queue->write_pos, memory_order_acquire);
 }
 
 SKA_API uint32_t ska_text_consume(void) {
 	ska_text_queue_t* queue = &g_ska.input_state.text_queue;
-	if (queue->count == 0) {
+	uint32_t read_pos  = atomic_load_explicit(&queue->read_pos,  memory_order_relaxed);
+	uint32_t write_pos = atomic_load_explicit(&queue->write_pos, memory_order_acquire);
+	if (read_pos == write_pos) {
 		return 0;
 	}
 
-	uint32_t codepoint = queue->codepoints[queue->read_pos];
-	queue->read_pos = (queue->read_pos + 1) % SKA_TEXT_QUEUE_SIZE;
-	queue->count--;
+	uint32_t codepoint = queue->codepoints[read_pos & (SKA_TEXT_QUEUE_SIZE - 1)];
+	atomic_store_explicit(&queue->read_pos, read_pos + 1, memory_order_release);
 	return codepoint;
 }
 
 SKA_API uint32_t ska_text_peek(void) {
 	ska_text_queue_t* queue = &g_ska.input_state.text_queue;
-	if (queue->count == 0) {
+	uint32_t read_pos  = atomic_load_explicit(&queue->read_pos,  memory_order_relaxed);
+	uint32_t write_pos = atomic_load_explicit(&queue->write_pos, memory_order_acquire);
+	if (read_pos == write_pos) {
 		return 0;
 	}
 
-	return queue->codepoints[queue->read_pos];
+	return queue->codepoints[read_pos & (SKA_TEXT_QUEUE_SIZE - 1)];
 }
 
 SKA_API void ska_text_reset(void) {
+	// Consumer-side reset: skip everything published so far
 	ska_text_queue_t* queue = &g_ska.input_state.text_queue;
-	queue->read_pos = 0;
-	queue->write_pos = 0;
-	queue->count = 0;
+	uint32_t write_pos = atomic_load_explicit(&queue->write_pos, memory_order_acquire);
+	atomic_store_explicit(&queue->read_pos, write_pos, memory_order_release);
 }
 
 SKA_API void ska_virtual_keyboard_show(bool visible, ska_text_input_type_ type) {
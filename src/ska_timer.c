@@ -0,0 +1,177 @@
+//
+// sk_app - Timers
+//
+// Timers live on the thread that polls events. Deadlines are kept in a
+// binary min-heap so the next one is always at the root; ska_event_pump()
+// posts the ones that are due and ska_event_wait_timeout() sleeps no later
+// than the root. Backends with a precise wakeup (timerfd on Linux) arm it
+// from ska_timer_next_deadline_ns().
+
+#include "ska_internal.h"
+
+typedef struct ska_timer_t {
+	uint64_t       deadline_ns; // ska_time_get_elapsed_ns() clock
+	uint64_t       interval_ns;
+	ska_timer_id_t id;
+	bool           repeat;
+	void*          user_data;
+} ska_timer_t;
+
+typedef struct ska_timer_state_t {
+	ska_timer_t*   heap;
+	int32_t        count;
+	int32_t        capacity;
+	ska_timer_id_t next_id;
+} ska_timer_state_t;
+
+static ska_timer_state_t g_ska_timer = {0};
+
+// ============================================================================
+// Heap
+// ============================================================================
+
+static void ska_timer_swap(int32_t a, int32_t b) {
+	ska_timer_t tmp     = g_ska_timer.heap[a];
+	g_ska_timer.heap[a] = g_ska_timer.heap[b];
+	g_ska_timer.heap[b] = tmp;
+}
+
+static void ska_timer_sift_up(int32_t index) {
+	while (index > 0) {
+		int32_t parent = (index - 1) / 2;
+		if (g_ska_timer.heap[parent].deadline_ns <= g_ska_timer.heap[index].deadline_ns) {
+			break;
+		}
+		ska_timer_swap(parent, index);
+		index = parent;
+	}
+}
+
+static void ska_timer_sift_down(int32_t index) {
+	while (true) {
+		int32_t smallest = index;
+		int32_t left     = index * 2 + 1;
+		int32_t right    = left + 1;
+		if (left  < g_ska_timer.count && g_ska_timer.heap[left ].deadline_ns < g_ska_timer.heap[smallest].deadline_ns) smallest = left;
+		if (right < g_ska_timer.count && g_ska_timer.heap[right].deadline_ns < g_ska_timer.heap[smallest].deadline_ns) smallest = right;
+		if (smallest == index) {
+			break;
+		}
+		ska_timer_swap(index, smallest);
+		index = smallest;
+	}
+}
+
+static void ska_timer_remove_at(int32_t index) {
+	g_ska_timer.count--;
+	if (index == g_ska_timer.count) {
+		return;
+	}
+	g_ska_timer.heap[index] = g_ska_timer.heap[g_ska_timer.count];
+	ska_timer_sift_down(index);
+	ska_timer_sift_up(index);
+}
+
+// ============================================================================
+// Internal
+// ============================================================================
+
+void ska_timer_pump(void) {
+	if (g_ska_timer.count == 0) {
+		return;
+	}
+
+	uint64_t now_ns = ska_time_get_elapsed_ns();
+	while (g_ska_timer.count > 0 && g_ska_timer.heap[0].deadline_ns <= now_ns) {
+		ska_timer_t* timer = &g_ska_timer.heap[0];
+
+		// A repeating timer that fell several intervals behind fires once
+		// and reports how many it covered, like a timerfd read
+		uint32_t expirations = 1;
+		if (timer->repeat) {
+			uint64_t behind = (now_ns - timer->deadline_ns) / timer->interval_ns;
+			expirations = behind >= UINT32_MAX ? UINT32_MAX : (uint32_t)behind + 1;
+		}
+
+		ska_event_t event = {0};
+		event.type              = ska_event_timer;
+		event.timestamp_ns      = timer->deadline_ns;
+		event.timer.timer_id    = timer->id;
+		event.timer.expirations = expirations;
+		event.timer.user_data   = timer->user_data;
+
+		if (timer->repeat) {
+			timer->deadline_ns += (uint64_t)expirations * timer->interval_ns;
+			ska_timer_sift_down(0);
+		} else {
+			ska_timer_remove_at(0);
+		}
+
+		// A threaded backend owns the queue, hand over like other threads do
+		if (g_ska.event_producer_threaded) {
+			ska_event_push(&event);
+		} else {
+			ska_post_event(&event);
+		}
+	}
+}
+
+uint64_t ska_timer_next_deadline_ns(void) {
+	return g_ska_timer.count > 0 ? g_ska_timer.heap[0].deadline_ns : UINT64_MAX;
+}
+
+void ska_timer_clear(void) {
+	free(g_ska_timer.heap);
+	memset(&g_ska_timer, 0, sizeof(g_ska_timer));
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+SKA_API ska_timer_id_t ska_timer_add(uint64_t interval_ns, bool repeat, void* opt_user_data) {
+	if (!g_ska.initialized) {
+		ska_set_error("ska_timer_add: sk_app not initialized");
+		return 0;
+	}
+	if (interval_ns == 0) {
+		ska_set_error("ska_timer_add: Interval must be greater than 0");
+		return 0;
+	}
+
+	if (g_ska_timer.count == g_ska_timer.capacity) {
+		int32_t      capacity = g_ska_timer.capacity > 0 ? g_ska_timer.capacity * 2 : 8;
+		ska_timer_t* heap     = (ska_timer_t*)realloc(g_ska_timer.heap, (size_t)capacity * sizeof(ska_timer_t));
+		if (!heap) {
+			ska_set_error("ska_timer_add: Out of memory");
+			return 0;
+		}
+		g_ska_timer.heap     = heap;
+		g_ska_timer.capacity = capacity;
+		ska_stats_add(allocations, 1);
+	}
+
+	// Skip 0 on wrap, it means failure
+	if (++g_ska_timer.next_id == 0) {
+		g_ska_timer.next_id = 1;
+	}
+
+	ska_timer_t* timer = &g_ska_timer.heap[g_ska_timer.count];
+	timer->deadline_ns = ska_time_get_elapsed_ns() + interval_ns;
+	timer->interval_ns = interval_ns;
+	timer->id          = g_ska_timer.next_id;
+	timer->repeat      = repeat;
+	timer->user_data   = opt_user_data;
+	ska_timer_sift_up(g_ska_timer.count++);
+	return g_ska_timer.next_id;
+}
+
+SKA_API bool ska_timer_remove(ska_timer_id_t id) {
+	for (int32_t i = 0; i < g_ska_timer.count; i++) {
+		if (g_ska_timer.heap[i].id == id) {
+			ska_timer_remove_at(i);
+			return true;
+		}
+	}
+	return false;
+}
@@ -151,12 +151,7 @@ static void ska_init_scancode_table(void) {
 }
 
 static ska_window_t* ska_find_window_by_hwnd(HWND hwnd) {
-	for (uint32_t i = 0; i < SKA_MAX_WINDOWS; i++) {
-		if (g_ska.windows[i] && g_ska.windows[i]->hwnd == hwnd) {
-			return g_ska.windows[i];
-		}
-	}
-	return NULL;
+	return ska_window_from_native((uintptr_t)hwnd);
 }
 
 static uint16_t ska_win32_get_modifiers(void) {
@@ -179,12 +174,25 @@ typedef UINT (WINAPI *PFN_GetDpiForWindow)(HWND);
 static PFN_GetDpiForWindow g_pfnGetDpiForWindow = NULL;
 static bool                g_dpi_func_loaded    = false;
 
+// GetDpiForMonitor is in shcore.dll, Windows 8.1+ (MDT_EFFECTIVE_DPI = 0)
+typedef HRESULT (WINAPI *PFN_GetDpiForMonitor)(HMONITOR, int, UINT*, UINT*);
+static PFN_GetDpiForMonitor g_pfnGetDpiForMonitor     = NULL;
+static bool                 g_dpi_monitor_func_loaded = false;
+
+// Enumerated on first use, then again on WM_DISPLAYCHANGE and work area changes
+static ska_display_info_t* g_win32_displays       = NULL;
+static int32_t             g_win32_display_count  = 0;
+static bool                g_win32_displays_valid = false;
+
 // SetProcessDpiAwarenessContext is available on Windows 10 1703+
 // DPI_AWARENESS_CONTEXT is a handle type (HANDLE on newer SDKs, void* for compatibility)
 typedef BOOL (WINAPI *PFN_SetProcessDpiAwarenessContext)(void*);
 // DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2 = ((DPI_AWARENESS_CONTEXT)-4)
 #define SKA_DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2 ((void*)(intptr_t)-4)
 
+// Display list, defined with the window getters
+static bool ska_win32_displays_update(void);
+
 static LRESULT CALLBACK ska_win32_window_proc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam) {
 	ska_window_t* window = ska_find_window_by_hwnd(hwnd);
 	if (!window && msg != WM_CREATE) {
@@ -201,6 +209,7 @@ static LRESULT CALLBACK ska_win32_window_proc(HWND hwnd, UINT msg, WPARAM wparam
 			if (window) {
 				window->hwnd = hwnd;
 				window->hdc = GetDC(hwnd);
+				ska_window_set_native(window, (uintptr_t)hwnd);
 			}
 			return 0;
 		}
@@ -472,6 +481,19 @@ static LRESULT CALLBACK ska_win32_window_proc(HWND hwnd, UINT msg, WPARAM wparam
 			}
 			break;
 
+		case WM_DISPLAYCHANGE:
+		case WM_SETTINGCHANGE:
+			// Every top-level window gets these, only the first one to see
+			// a difference in the display list posts the event
+			if (msg == WM_DISPLAYCHANGE || wparam == SPI_SETWORKAREA) {
+				if (ska_win32_displays_update()) {
+					event.type         = ska_event_display_changed;
+					event.window.data1 = ska_platform_display_count();
+					ska_post_event(&event);
+				}
+			}
+			break;
+
 		case WM_DPICHANGED: {
 			if (window) {
 				// wparam contains new DPI: LOWORD = X DPI, HIWORD = Y DPI
@@ -505,6 +527,7 @@ static LRESULT CALLBACK ska_win32_window_proc(HWND hwnd, UINT msg, WPARAM wparam
 
 bool ska_platform_init(void) {
 	g_ska.hinstance = GetModuleHandle(NULL);
+	g_ska.main_thread_id = GetCurrentThreadId();
 
 	// Enable high-DPI awareness (per-monitor DPI v2 on Windows 10 1703+)
 	// Try SetProcessDpiAwarenessContext first (best option for modern Windows)
@@ -545,6 +568,11 @@ bool ska_platform_init(void) {
 }
 
 void ska_platform_shutdown(void) {
+	free(g_win32_displays);
+	g_win32_displays       = NULL;
+	g_win32_display_count  = 0;
+	g_win32_displays_valid = false;
+
 	if (g_ska.window_class_registered) {
 		UnregisterClassW(L"ska_window", g_ska.hinstance);
 		g_ska.window_class_registered = false;
@@ -654,6 +682,7 @@ void ska_platform_window_destroy(ska_window_t* window) {
 	if (window->hwnd) {
 		DestroyWindow(window->hwnd);
 		window->hwnd = NULL;
+		ska_window_set_native(window, 0); // The handle may be handed out again
 	}
 }
 
@@ -817,6 +846,104 @@ float ska_platform_get_refresh_rate(const ska_window_t* window) {
 	return (float)dm.dmDisplayFrequency;
 }
 
+static float ska_win32_monitor_dpi_scale(HMONITOR monitor) {
+	if (!g_dpi_monitor_func_loaded) {
+		g_dpi_monitor_func_loaded = true;
+		HMODULE shcore = LoadLibraryW(L"shcore.dll");
+		if (shcore) {
+			g_pfnGetDpiForMonitor = (PFN_GetDpiForMonitor)(void(*)(void))GetProcAddress(shcore, "GetDpiForMonitor");
+		}
+	}
+
+	UINT dpi_x = 0, dpi_y = 0;
+	if (g_pfnGetDpiForMonitor && SUCCEEDED(g_pfnGetDpiForMonitor(monitor, 0, &dpi_x, &dpi_y)) && dpi_x > 0) {
+		return (float)dpi_x / 96.0f;
+	}
+	return ska_platform_get_dpi_scale(NULL); // System DPI
+}
+
+typedef struct ska_win32_display_list_t {
+	ska_display_info_t* displays;
+	int32_t             count;
+	int32_t             capacity;
+} ska_win32_display_list_t;
+
+static BOOL CALLBACK ska_win32_display_enum(HMONITOR monitor, HDC hdc, LPRECT rect, LPARAM lparam) {
+	(void)hdc;
+	(void)rect;
+	ska_win32_display_list_t* list = (ska_win32_display_list_t*)lparam;
+
+	if (list->count == list->capacity) {
+		int32_t             capacity = list->capacity > 0 ? list->capacity * 2 : 4;
+		ska_display_info_t* displays = (ska_display_info_t*)realloc(list->displays, (size_t)capacity * sizeof(ska_display_info_t));
+		if (!displays) {
+			return FALSE;
+		}
+		list->displays = displays;
+		list->capacity = capacity;
+	}
+
+	MONITORINFOEXA mi;
+	mi.cbSize = sizeof(mi);
+	if (!GetMonitorInfoA(monitor, (MONITORINFO*)&mi)) {
+		return TRUE;
+	}
+
+	ska_display_info_t* info = &list->displays[list->count++];
+	memset(info, 0, sizeof(*info));
+	snprintf(info->name, sizeof(info->name), "%s", mi.szDevice);
+	info->x           = mi.rcMonitor.left;
+	info->y           = mi.rcMonitor.top;
+	info->width       = mi.rcMonitor.right  - mi.rcMonitor.left;
+	info->height      = mi.rcMonitor.bottom - mi.rcMonitor.top;
+	info->work_x      = mi.rcWork.left;
+	info->work_y      = mi.rcWork.top;
+	info->work_width  = mi.rcWork.right  - mi.rcWork.left;
+	info->work_height = mi.rcWork.bottom - mi.rcWork.top;
+	info->is_primary  = (mi.dwFlags & MONITORINFOF_PRIMARY) != 0;
+	info->dpi_scale   = ska_win32_monitor_dpi_scale(monitor);
+
+	DEVMODEA dm;
+	dm.dmSize = sizeof(dm);
+	dm.dmDriverExtra = 0;
+	if (EnumDisplaySettingsA(mi.szDevice, ENUM_CURRENT_SETTINGS, &dm) && dm.dmDisplayFrequency > 1) {
+		info->refresh_rate = (float)dm.dmDisplayFrequency; // 0 and 1 mean "hardware default"
+	}
+	return TRUE;
+}
+
+// Re-enumerates the displays, returns true if the list differs from the last one
+static bool ska_win32_displays_update(void) {
+	ska_win32_display_list_t list = {0};
+	if (!EnumDisplayMonitors(NULL, NULL, ska_win32_display_enum, (LPARAM)&list) || list.count == 0) {
+		free(list.displays);
+		return false; // Keep what we had
+	}
+
+	bool changed = !g_win32_displays_valid || list.count != g_win32_display_count ||
+		memcmp(list.displays, g_win32_displays, (size_t)list.count * sizeof(ska_display_info_t)) != 0;
+	free(g_win32_displays);
+	g_win32_displays       = list.displays;
+	g_win32_display_count  = list.count;
+	g_win32_displays_valid = true;
+	return changed;
+}
+
+int32_t ska_platform_display_count(void) {
+	if (!g_win32_displays_valid) {
+		ska_win32_displays_update();
+	}
+	return g_win32_display_count;
+}
+
+bool ska_platform_display_get_info(int32_t index, ska_display_info_t* out_info) {
+	if (index < 0 || index >= ska_platform_display_count()) {
+		return false;
+	}
+	*out_info = g_win32_displays[index];
+	return true;
+}
+
 void ska_platform_warp_mouse(ska_window_t* window, int32_t x, int32_t y) {
 	POINT pt = { x, y };
 	ClientToScreen(window->hwnd, &pt);
@@ -860,7 +987,7 @@ void ska_platform_show_cursor(bool show) {
 bool ska_platform_set_relative_mouse_mode(bool enabled) {
 	if (enabled) {
 		// Clip cursor to client area
-		ska_window_t* window = g_ska.windows[0];  // Use first window
+		ska_window_t* window = g_ska.window_count > 0 ? g_ska.windows[0] : NULL;  // Use first window
 		if (window && window->hwnd) {
 			RECT rect;
 			GetClientRect(window->hwnd, &rect);
@@ -894,6 +1021,29 @@ void ska_platform_pump_events(void) {
 	ska_win32_check_file_dialog();
 }
 
+// Defined with the file dialog code below
+static HANDLE ska_win32_file_dialog_thread(void);
+
+void ska_platform_wait_events(int32_t timeout_ms) {
+	// The dialog thread handle signals when the dialog closes, so a pending
+	// file dialog result also wakes us without polling
+	HANDLE handles[1];
+	DWORD  handle_count = 0;
+	HANDLE dialog_thread = ska_win32_file_dialog_thread();
+	if (dialog_thread) {
+		handles[handle_count++] = dialog_thread;
+	}
+
+	MsgWaitForMultipleObjectsEx(handle_count, handles,
+		timeout_ms < 0 ? INFINITE : (DWORD)timeout_ms,
+		QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+}
+
+void ska_platform_wake(void) {
+	// A posted thread message satisfies QS_ALLINPUT, the pump discards it
+	PostThreadMessageW(g_ska.main_thread_id, WM_NULL, 0, 0);
+}
+
 /////////////////////////////////////////
 // Win32 specific subset of Vulkan header
 /////////////////////////////////////////
@@ -1229,6 +1379,10 @@ bool ska_platform_file_dialog_show(ska_file_dialog_id_t id, const ska_file_dialo
 	return true;
 }
 
+static HANDLE ska_win32_file_dialog_thread(void) {
+	return g_win32_file_dialog.active ? g_win32_file_dialog.thread : NULL;
+}
+
 // Called from ska_platform_pump_events to check for dialog completion
 static void ska_win32_check_file_dialog(void) {
 	if (!g_win32_file_dialog.active || !g_win32_file_dialog.completed) {